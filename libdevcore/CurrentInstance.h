@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+namespace dev
+{
+
+/**
+ * The instance of @a T used by the current thread.
+ * This is a process-wide default instance unless a Scope installed a different
+ * instance on the thread. This keeps the state of independent users of @a T,
+ * e.g. compilations running concurrently on different threads, apart.
+ */
+template <class T>
+class CurrentInstance
+{
+public:
+	static T& get()
+	{
+		if (T* instance = installed())
+			return *instance;
+		static T defaultInstance;
+		return defaultInstance;
+	}
+
+	/// Makes @a _instance the current instance of the thread for the lifetime of the scope.
+	class Scope
+	{
+	public:
+		explicit Scope(T& _instance): m_previous(installed()) { installed() = &_instance; }
+		~Scope() { installed() = m_previous; }
+		Scope(Scope const&) = delete;
+		Scope& operator=(Scope const&) = delete;
+
+	private:
+		T* m_previous;
+	};
+
+private:
+	static T*& installed()
+	{
+		static thread_local T* instance = nullptr;
+		return instance;
+	}
+};
+
+}
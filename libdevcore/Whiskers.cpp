@@ -25,11 +25,129 @@
 
 #include <libdevcore/Assertions.h>
 
-#include <regex>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace dev;
 
+/// A template split into text and parameters. The parts of lists and conditions are
+/// parsed recursively.
+struct Whiskers::Template
+{
+	struct Element
+	{
+		enum class Kind { Text, Value, List, Condition };
+		Kind kind;
+		/// The text or the name of the parameter.
+		string value;
+		/// The body of a list or the first part of a condition.
+		unique_ptr<Template> body;
+		/// The second part of a condition (empty if missing).
+		unique_ptr<Template> elseBody;
+	};
+
+	explicit Template(string _text);
+
+	string text;
+	vector<Element> elements;
+};
+
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _pos (@a _pos if there is none).
+size_t parameterEnd(string const& _text, size_t _pos)
+{
+	while (_pos < _text.size() && isParameterCharacter(_text[_pos]))
+		++_pos;
+	return _pos;
+}
+
+/// Number of parsed templates above which the cache is cleared.
+size_t const c_maxCachedTemplates = 4096;
+
+}
+
+Whiskers::Template::Template(string _text):
+	text(move(_text))
+{
+	// Tags are matched like the regular expression
+	//   <(P)>|<#(P)>(.*?)</\2>|<\?(P)>(.*?)(<!\4>(.*?))?</\4>
+	// where P is [a-zA-Z0-9_$-]+, i.e. at the first possible position, and the
+	// parts of lists and conditions end at the first matching closing tag.
+	size_t textStart = 0;
+	size_t pos = 0;
+	auto addText = [&](size_t _end)
+	{
+		if (textStart < _end)
+			elements.push_back(Element{Element::Kind::Text, text.substr(textStart, _end - textStart), nullptr, nullptr});
+	};
+	while ((pos = text.find('<', pos)) != string::npos)
+	{
+		size_t nameStart = pos + 1;
+		if (nameStart < text.size() && (text[nameStart] == '#' || text[nameStart] == '?'))
+			++nameStart;
+		size_t nameEnd = parameterEnd(text, nameStart);
+		if (nameEnd == nameStart || nameEnd >= text.size() || text[nameEnd] != '>')
+		{
+			++pos;
+			continue;
+		}
+		string name = text.substr(nameStart, nameEnd - nameStart);
+		size_t bodyStart = nameEnd + 1;
+
+		Element element{Element::Kind::Value, name, nullptr, nullptr};
+		size_t end = bodyStart;
+		if (nameStart != pos + 1)
+		{
+			string closing = "</" + name + ">";
+			size_t closingPos = text.find(closing, bodyStart);
+			if (closingPos == string::npos)
+			{
+				++pos;
+				continue;
+			}
+			end = closingPos + closing.size();
+			if (text[pos + 1] == '#')
+			{
+				element.kind = Element::Kind::List;
+				element.body = make_unique<Template>(text.substr(bodyStart, closingPos - bodyStart));
+			}
+			else
+			{
+				element.kind = Element::Kind::Condition;
+				string elseTag = "<!" + name + ">";
+				size_t elsePos = text.find(elseTag, bodyStart);
+				if (elsePos < closingPos)
+				{
+					element.body = make_unique<Template>(text.substr(bodyStart, elsePos - bodyStart));
+					size_t elseStart = elsePos + elseTag.size();
+					element.elseBody = make_unique<Template>(text.substr(elseStart, closingPos - elseStart));
+				}
+				else
+				{
+					element.body = make_unique<Template>(text.substr(bodyStart, closingPos - bodyStart));
+					element.elseBody = make_unique<Template>(string());
+				}
+			}
+		}
+		addText(pos);
+		elements.push_back(move(element));
+		pos = textStart = end;
+	}
+	addText(text.size());
+}
+
 Whiskers::Whiskers(string _template):
 	m_template(move(_template))
 {
@@ -67,14 +185,17 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	shared_ptr<Template const> parsed = parse(m_template);
+	string result;
+	result.reserve(m_template.size());
+	render(*parsed, m_parameters, nullptr, m_conditions, m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && parameterEnd(_parameter, 0) == _parameter.size(),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -99,97 +220,95 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 	);
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+shared_ptr<Whiskers::Template const> Whiskers::parse(string const& _template)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Template const>> cache;
+
+	lock_guard<mutex> lock(cacheMutex);
+	auto it = cache.find(_template);
+	if (it != cache.end())
+		return it->second;
+	// Templates are mostly string literals, but some are built at runtime.
+	if (cache.size() >= c_maxCachedTemplates)
+		cache.clear();
+	return cache[_template] = make_shared<Template const>(_template);
 }
 
-string Whiskers::replace(
-	string const& _template,
+void Whiskers::render(
+	Template const& _template,
 	StringMap const& _parameters,
+	StringMap const* _listElement,
 	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
+	StringListMap const& _listParameters,
+	string& _result
 )
 {
-	static regex listOrTag("<(" + paramRegex() + ")>|<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|<\\?(" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>");
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+	for (auto const& element: _template.elements)
+		switch (element.kind)
+		{
+		case Template::Element::Kind::Text:
+			_result += element.value;
+			break;
+		case Template::Element::Kind::Value:
 		{
+			if (_listElement)
+			{
+				auto it = _listElement->find(element.value);
+				if (it != _listElement->end())
+				{
+					_result += it->second;
+					break;
+				}
+			}
+			auto it = _parameters.find(element.value);
 			assertThrow(
-				_parameters.count(tagName),
+				it != _parameters.end(),
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + element.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.text
 			);
-			return _parameters.at(tagName);
+			_result += it->second;
+			break;
 		}
-		else if (!listName.empty())
+		case Template::Element::Kind::List:
 		{
-			string templ(_match[3]);
+			auto it = _listParameters.find(element.value);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				it != _listParameters.end(),
+				WhiskersError, "List parameter " + element.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			// Lists cannot contain lists.
+			static StringListMap const noListParameters;
+			for (auto const& listElement: it->second)
+			{
+				for (auto const& parameter: listElement)
+					assertThrow(
+						!_parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(*element.body, _parameters, &listElement, _conditions, noListParameters, _result);
+			}
+			break;
 		}
-		else
+		case Template::Element::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
+			auto it = _conditions.find(element.value);
 			assertThrow(
-				_conditions.count(conditionName),
-				WhiskersError, "Condition parameter " + conditionName + " not set."
+				it != _conditions.end(),
+				WhiskersError, "Condition parameter " + element.value + " not set."
 			);
-			return replace(
-				_conditions.at(conditionName) ? _match[5] : _match[7],
+			render(
+				it->second ? *element.body : *element.elseBody,
 				_parameters,
+				_listElement,
 				_conditions,
-				_listParameters
+				_listParameters,
+				_result
 			);
+			break;
+		}
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
 }
-
@@ -27,6 +27,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace dev
@@ -85,23 +86,29 @@ public:
 	std::string render() const;
 
 private:
+	/// Template parsed into text and parameters (see Whiskers.cpp).
+	struct Template;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	static std::string replace(
-		std::string const& _template,
+	/// @returns the parsed template, templates are parsed once and shared by all
+	/// Whiskers objects with the same template string.
+	static std::shared_ptr<Template const> parse(std::string const& _template);
+
+	/// Appends the rendered template to @a _result. @a _listElement contains the parameters
+	/// of the current list element (if any), they take precedence over @a _parameters.
+	static void render(
+		Template const& _template,
 		StringMap const& _parameters,
+		StringMap const* _listElement,
 		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
+		StringListMap const& _listParameters,
+		std::string& _result
 	);
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
 	std::string m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
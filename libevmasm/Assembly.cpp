@@ -28,8 +28,12 @@
 #include <libevmasm/BlockDeduplicator.h>
 #include <libevmasm/ConstantOptimiser.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/SemanticInformation.h>
 
+#include <atomic>
 #include <fstream>
+#include <functional>
+#include <thread>
 #include <json/json.h>
 
 using namespace std;
@@ -37,6 +41,72 @@ using namespace dev;
 using namespace dev::eth;
 using namespace langutil;
 
+namespace
+{
+
+/// Minimal number of CSE blocks for running an extra thread.
+size_t const c_minBlocksPerThread = 64;
+
+/// Number of threads started by parallelFor that are still running. Nested calls (for
+/// sub-assemblies) and calls from concurrent compilations share one thread per core.
+atomic<size_t> g_runningWorkers{0};
+
+/// Reserves up to @a _wanted additional threads within the limit.
+/// @returns the number of reserved threads.
+size_t reserveWorkers(size_t _wanted)
+{
+	size_t const limit = max<size_t>(thread::hardware_concurrency(), 1) - 1;
+	size_t running = g_runningWorkers.load();
+	size_t reserved = 0;
+	do
+		reserved = min(_wanted, running < limit ? limit - running : 0);
+	while (reserved > 0 && !g_runningWorkers.compare_exchange_weak(running, running + reserved));
+	return reserved;
+}
+
+/// Calls @a _task for each index below @a _count, using up to one thread per core with
+/// at least @a _minCountPerThread indices each. The calling thread takes part, further
+/// threads are only started while the limit of reserveWorkers allows.
+/// The first exception (by index) is rethrown.
+void parallelFor(size_t _count, size_t _minCountPerThread, function<void(size_t)> const& _task)
+{
+	size_t wanted = _count / _minCountPerThread;
+	size_t extraThreads = wanted > 1 ? reserveWorkers(wanted - 1) : 0;
+	if (extraThreads == 0)
+	{
+		for (size_t i = 0; i < _count; ++i)
+			_task(i);
+		return;
+	}
+
+	atomic<size_t> next{0};
+	vector<exception_ptr> errors(_count);
+	auto work = [&]()
+	{
+		for (size_t i = next++; i < _count; i = next++)
+			try
+			{
+				_task(i);
+			}
+			catch (...)
+			{
+				errors[i] = current_exception();
+			}
+	};
+	vector<thread> workers;
+	for (size_t i = 0; i < extraThreads; ++i)
+		workers.emplace_back(work);
+	work();
+	for (auto& worker: workers)
+		worker.join();
+	g_runningWorkers -= extraThreads;
+	for (auto const& error: errors)
+		if (error)
+			rethrow_exception(error);
+}
+
+}
+
 void Assembly::append(Assembly const& _a)
 {
 	auto newDeposit = m_deposit + _a.deposit();
@@ -393,21 +463,45 @@ map<u256, u256> Assembly::optimiseInternal(
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
-	// Run optimisation for sub-assemblies.
-	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	// Run optimisation for sub-assemblies. They are independent unless they share
+	// assemblies (e.g. a contract created both by the constructor and the runtime code),
+	// in which case they are optimised in order.
+	set<Assembly const*> reachedSubs;
+	bool disjointSubs = true;
+	function<void(Assembly const&)> reachSubs = [&](Assembly const& _assembly)
+	{
+		for (auto const& sub: _assembly.m_subs)
+			if (reachedSubs.insert(sub.get()).second)
+				reachSubs(*sub);
+			else
+				disjointSubs = false;
+	};
+	reachSubs(*this);
+
+	vector<map<u256, u256>> subTagReplacements(m_subs.size());
+	auto optimiseSub = [&](size_t subId)
 	{
 		OptimiserSettings settings = _settings;
 		// Disable creation mode for sub-assemblies.
 		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
+		subTagReplacements[subId] = m_subs[subId]->optimiseInternal(
 			settings,
 			JumpdestRemover::referencedTags(m_items, subId)
 		);
-		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+	};
+	if (disjointSubs)
+		parallelFor(m_subs.size(), 1, optimiseSub);
+	else
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			optimiseSub(subId);
+	// Apply the replacements (can be empty).
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
+	// Blocks that the CSE could not improve, they are skipped in the next iterations.
+	set<AssemblyItems> unimprovableBlocks;
+	bool unimprovableUsesMSize = false;
 	// Iterate until no new optimisation possibilities are found.
 	for (unsigned count = 1; count > 0;)
 	{
@@ -461,23 +555,49 @@ map<u256, u256> Assembly::optimiseInternal(
 			// Control flow graph optimization has been here before but is disabled because it
 			// assumes we only jump to tags that are pushed. This is not the case anymore with
 			// function types that can be stored in storage.
-			AssemblyItems optimisedItems;
-
 			bool usesMSize = (find(m_items.begin(), m_items.end(), AssemblyItem{Instruction::MSIZE}) != m_items.end());
+			if (usesMSize != unimprovableUsesMSize)
+			{
+				unimprovableBlocks.clear();
+				unimprovableUsesMSize = usesMSize;
+			}
 
-			auto iter = m_items.begin();
-			while (iter != m_items.end())
+			// Split the items into the blocks analysed by the CSE, each block ends
+			// with the item breaking it (if any).
+			vector<pair<size_t, size_t>> blocks;
+			for (size_t begin = 0; begin < m_items.size();)
 			{
+				size_t end = begin;
+				while (end < m_items.size() && !SemanticInformation::breaksCSEAnalysisBlock(m_items[end], usesMSize))
+					++end;
+				if (end < m_items.size())
+					++end;
+				blocks.emplace_back(begin, end);
+				begin = end;
+			}
+
+			// Each block is analysed starting from an empty state, so the blocks
+			// are optimised in parallel.
+			vector<AssemblyItems> optimisedBlocks(blocks.size());
+			vector<char> replaceBlock(blocks.size(), false);
+			vector<char> skippedBlock(blocks.size(), false);
+			parallelFor(blocks.size(), c_minBlocksPerThread, [&](size_t _block)
+			{
+				auto begin = m_items.begin() + blocks[_block].first;
+				auto end = m_items.begin() + blocks[_block].second;
+				if (unimprovableBlocks.count(AssemblyItems(begin, end)))
+				{
+					skippedBlock[_block] = true;
+					return;
+				}
 				KnownState emptyState;
 				CommonSubexpressionEliminator eliminator{emptyState};
-				auto orig = iter;
-				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
-				bool shouldReplace = false;
-				AssemblyItems optimisedChunk;
+				auto iter = eliminator.feedItems(begin, end, usesMSize);
+				assertThrow(iter == end, OptimizerException, "Invalid CSE block.");
 				try
 				{
-					optimisedChunk = eliminator.getOptimizedItems();
-					shouldReplace = (optimisedChunk.size() < size_t(iter - orig));
+					optimisedBlocks[_block] = eliminator.getOptimizedItems();
+					replaceBlock[_block] = (optimisedBlocks[_block].size() < size_t(end - begin));
 				}
 				catch (StackTooDeepException const&)
 				{
@@ -489,14 +609,24 @@ map<u256, u256> Assembly::optimiseInternal(
 					// This might happen if e.g. associativity and commutativity rules
 					// reorganise the expression tree, but not all leaves are available.
 				}
+			});
 
-				if (shouldReplace)
+			AssemblyItems optimisedItems;
+			for (size_t block = 0; block < blocks.size(); ++block)
+			{
+				auto begin = m_items.begin() + blocks[block].first;
+				auto end = m_items.begin() + blocks[block].second;
+				if (replaceBlock[block])
 				{
 					count++;
-					optimisedItems += optimisedChunk;
+					optimisedItems += optimisedBlocks[block];
 				}
 				else
-					copy(orig, iter, back_inserter(optimisedItems));
+				{
+					copy(begin, end, back_inserter(optimisedItems));
+					if (!skippedBlock[block])
+						unimprovableBlocks.insert(AssemblyItems(begin, end));
+				}
 			}
 			if (optimisedItems.size() < m_items.size())
 			{
@@ -608,7 +738,7 @@ LinkerObject const& Assembly::assemble() const
 		{
 			assertThrow(i.data() <= size_t(-1), AssemblyException, "");
 			auto s = m_subs.at(size_t(i.data()))->assemble().bytecode.size();
-			i.setPushedValue(u256(s));
+			i.setPushedValue(s);
 			uint8_t b = max<unsigned>(1, dev::bytesRequired(s));
 			ret.bytecode.push_back((uint8_t)Instruction::PUSH1 - 1 + b);
 			ret.bytecode.resize(ret.bytecode.size() + b);
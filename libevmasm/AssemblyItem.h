@@ -27,6 +27,9 @@
 #include <libdevcore/Common.h>
 #include <libdevcore/Assertions.h>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
 #include <sstream>
 
 namespace dev
@@ -54,7 +57,7 @@ class Assembly;
 class AssemblyItem
 {
 public:
-	enum class JumpType { Ordinary, IntoFunction, OutOfFunction };
+	enum class JumpType: uint8_t { Ordinary, IntoFunction, OutOfFunction };
 
 	AssemblyItem(u256 _push, langutil::SourceLocation _location = langutil::SourceLocation()):
 		AssemblyItem(Push, std::move(_push), std::move(_location)) { }
@@ -70,7 +73,7 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			setData(_data);
 	}
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
@@ -89,8 +92,22 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const
+	{
+		assertThrow(m_type != Operation, Exception, "");
+		return m_largeData ? *m_largeData : u256(m_smallData);
+	}
+	void setData(u256 const& _data)
+	{
+		assertThrow(m_type != Operation, Exception, "");
+		if (_data <= std::numeric_limits<uint64_t>::max())
+		{
+			m_smallData = uint64_t(_data);
+			m_largeData.reset();
+		}
+		else
+			m_largeData = std::make_shared<u256 const>(_data);
+	}
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, Exception, ""); return m_instruction; }
@@ -102,6 +119,8 @@ public:
 			return false;
 		if (type() == Operation)
 			return instruction() == _other.instruction();
+		else if (!m_largeData && !_other.m_largeData)
+			return m_smallData == _other.m_smallData;
 		else
 			return data() == _other.data();
 	}
@@ -113,6 +132,8 @@ public:
 			return type() < _other.type();
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
+		else if (!m_largeData && !_other.m_largeData)
+			return m_smallData < _other.m_smallData;
 		else
 			return data() < _other.data();
 	}
@@ -141,20 +162,29 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(size_t _value) const { m_pushedValue = _value; m_hasPushedValue = true; }
+	std::optional<u256> pushedValue() const
+	{
+		return m_hasPushedValue ? std::optional<u256>(m_pushedValue) : std::nullopt;
+	}
 
 	std::string toAssemblyText() const;
 
 private:
+	// The item is kept small (one cache line) and cheap to copy: data fitting into
+	// 64 bits (instructions, tags, most constants) is stored inline.
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
+	mutable bool m_hasPushedValue = false;
+	/// Data (only valid if m_type != Operation) if it fits into 64 bits.
+	uint64_t m_smallData = 0;
+	/// Data (only valid if m_type != Operation) not fitting into 64 bits, shared by copies.
+	std::shared_ptr<u256 const> m_largeData;
+	langutil::SourceLocation m_location;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	mutable uint64_t m_pushedValue = 0;
 };
 
 using AssemblyItems = std::vector<AssemblyItem>;
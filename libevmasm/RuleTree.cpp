@@ -0,0 +1,80 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Decision tree selecting the simplification rules that can match an expression.
+ */
+
+#include <libevmasm/RuleTree.h>
+
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+using namespace dev;
+using namespace dev::eth;
+
+bool RuleTreeLabel::operator<(RuleTreeLabel const& _other) const
+{
+	return tie(kind, value, arguments) < tie(_other.kind, _other.value, _other.arguments);
+}
+
+void RuleTree::insert(vector<optional<RuleTreeLabel>> const& _pattern, size_t _rule)
+{
+	Node* node = &m_root;
+	for (auto const& label: _pattern)
+	{
+		unique_ptr<Node>& next = label ? node->children[*label] : node->any;
+		if (!next)
+			next = make_unique<Node>();
+		node = next.get();
+	}
+	node->rules.push_back(_rule);
+}
+
+void RuleTree::candidates(vector<Term> const& _terms, vector<size_t>& _rules) const
+{
+	size_t first = _rules.size();
+	collect(m_root, _terms, 0, _rules);
+	// Every rule is stored in a single leaf and every leaf is reached at most once.
+	sort(_rules.begin() + first, _rules.end());
+}
+
+void RuleTree::collect(Node const& _node, vector<Term> const& _terms, size_t _position, vector<size_t>& _rules) const
+{
+	if (_position == _terms.size())
+	{
+		_rules.insert(_rules.end(), _node.rules.begin(), _node.rules.end());
+		return;
+	}
+
+	Term const& term = _terms[_position];
+	if (_node.any)
+		collect(*_node.any, _terms, term.end, _rules);
+	auto follow = [&](optional<u256> const& _value, bool _arguments)
+	{
+		auto it = _node.children.find(RuleTreeLabel{term.kind, _value, _arguments});
+		if (it != _node.children.end())
+			collect(*it->second, _terms, _arguments ? _position + 1 : term.end, _rules);
+	};
+	follow(term.value, true);
+	follow(term.value, false);
+	if (term.value)
+	{
+		follow(nullopt, true);
+		follow(nullopt, false);
+	}
+}
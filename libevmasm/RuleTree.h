@@ -0,0 +1,97 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Decision tree selecting the simplification rules that can match an expression.
+ */
+
+#pragma once
+
+#include <libdevcore/Common.h>
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace dev
+{
+namespace eth
+{
+
+/**
+ * Label of a node of a pattern.
+ */
+struct RuleTreeLabel
+{
+	/// Kind of the node, only compared by the tree (e.g. operation or constant).
+	unsigned kind = 0;
+	/// Instruction of an operation or value of a constant, none if any value matches.
+	std::optional<u256> value;
+	/// Whether the nodes that follow match the arguments of the subterm.
+	bool arguments = false;
+
+	bool operator<(RuleTreeLabel const& _other) const;
+};
+
+/**
+ * Discrimination tree over the patterns of a list of simplification rules. Trying
+ * the rules one after another costs a full pattern match per rule, the tree finds
+ * the rules that can match an expression in a single walk over the expression.
+ *
+ * Patterns are inserted as their nodes in pre-order, where a node that matches anything
+ * stands for a whole subterm. Expressions are flattened the same way (up to the depth of
+ * the deepest pattern), so each subterm is classified once. The result is the set of
+ * rules whose patterns have the right shape, operations and constants. Whether the
+ * subterms of a repeated match group are equal is left to the pattern itself.
+ */
+class RuleTree
+{
+public:
+	/// Subterm of an expression.
+	struct Term
+	{
+		/// Kind of the subterm, a kind not used by any label if no pattern node matches it.
+		unsigned kind = 0;
+		/// Instruction of an operation or value of a constant.
+		std::optional<u256> value;
+		/// Index of the term following the subterm and its arguments.
+		size_t end = 0;
+	};
+
+	/// Adds the rule with index @a _rule, whose pattern has the nodes @a _pattern in pre-order
+	/// (no label for nodes matching anything).
+	void insert(std::vector<std::optional<RuleTreeLabel>> const& _pattern, size_t _rule);
+
+	/// Appends the indices of the rules that can match the expression flattened in pre-order
+	/// into @a _terms to @a _rules, in increasing order.
+	void candidates(std::vector<Term> const& _terms, std::vector<size_t>& _rules) const;
+
+private:
+	struct Node
+	{
+		std::unique_ptr<Node> any;
+		std::map<RuleTreeLabel, std::unique_ptr<Node>> children;
+		std::vector<size_t> rules;
+	};
+
+	void collect(Node const& _node, std::vector<Term> const& _terms, size_t _position, std::vector<size_t>& _rules) const;
+
+	Node m_root;
+};
+
+}
+}
@@ -48,8 +48,13 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	m_terms.clear();
+	flatten(_expr, _classes, 1);
+	m_candidates.clear();
+	m_tree.candidates(m_terms, m_candidates);
+	for (size_t index: m_candidates)
 	{
+		auto const& rule = m_rules[index];
 		if (rule.pattern.matches(_expr, _classes))
 			if (!rule.feasible || rule.feasible())
 				return &rule;
@@ -61,7 +66,7 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return !m_rules.empty();
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -72,7 +77,34 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	assertThrow(_rule.pattern.type() == Operation, OptimizerException, "");
+	vector<optional<RuleTreeLabel>> labels;
+	m_depth = max(m_depth, _rule.pattern.appendTreeLabels(labels));
+	m_tree.insert(labels, m_rules.size());
+	m_rules.push_back(_rule);
+}
+
+void Rules::flatten(Expression const& _expr, ExpressionClasses const& _classes, unsigned _depth)
+{
+	size_t index = m_terms.size();
+	m_terms.emplace_back();
+	if (!_expr.item)
+		// Only matched by patterns that match anything.
+		m_terms[index].kind = UndefinedItem;
+	else if (_expr.item->type() == Operation)
+	{
+		m_terms[index].kind = Operation;
+		m_terms[index].value = unsigned(_expr.item->instruction());
+		if (_depth < m_depth)
+			for (ExpressionClasses::Id argument: _expr.arguments)
+				flatten(_classes.representative(argument), _classes, _depth + 1);
+	}
+	else
+	{
+		m_terms[index].kind = _expr.item->type();
+		m_terms[index].value = _expr.item->data();
+	}
+	m_terms[index].end = m_terms.size();
 }
 
 Rules::Rules()
@@ -106,8 +138,9 @@ Pattern::Pattern(Instruction _instruction, std::initializer_list<Pattern> _argum
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, Rules::MatchGroups& _matchGroups)
 {
+	assertThrow(_group > 0 && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -118,9 +151,10 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
-			(*m_matchGroups)[m_matchGroup] = &_expr;
-		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
+		Expression const*& match = (*m_matchGroups)[m_matchGroup];
+		if (!match)
+			match = &_expr;
+		else if (match->id != _expr.id)
 			return false;
 	}
 	assertThrow(m_arguments.size() == 0 || _expr.arguments.size() == m_arguments.size(), OptimizerException, "");
@@ -130,6 +164,21 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 	return true;
 }
 
+unsigned Pattern::appendTreeLabels(vector<optional<RuleTreeLabel>>& _labels) const
+{
+	assertThrow(m_type == Operation || m_arguments.empty(), OptimizerException, "Arguments for non-operation.");
+	if (m_type == UndefinedItem)
+		_labels.emplace_back(nullopt);
+	else if (m_type == Operation)
+		_labels.emplace_back(RuleTreeLabel{Operation, unsigned(m_instruction), !m_arguments.empty()});
+	else
+		_labels.emplace_back(RuleTreeLabel{m_type, m_requireDataMatch ? optional<u256>(data()) : nullopt, false});
+	unsigned depth = 0;
+	for (Pattern const& argument: m_arguments)
+		depth = max(depth, argument.appendTreeLabels(_labels));
+	return depth + 1;
+}
+
 AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
 {
 	if (m_type == Operation)
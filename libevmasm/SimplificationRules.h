@@ -24,13 +24,16 @@
 #pragma once
 
 #include <libevmasm/ExpressionClasses.h>
+#include <libevmasm/RuleTree.h>
 #include <libevmasm/SimplificationRule.h>
 
 #include <libdevcore/CommonData.h>
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
 #include <functional>
+#include <optional>
 #include <vector>
 
 namespace langutil
@@ -47,11 +50,15 @@ class Pattern;
 
 /**
  * Container for all simplification rules.
+ * The rules are compiled into a RuleTree, so that only the rules that can match
+ * an expression are tried.
  */
 class Rules: public boost::noncopyable
 {
 public:
 	using Expression = ExpressionClasses::Expression;
+	/// Expressions matched by the match groups of a rule, indexed by the group (starting at 1).
+	using MatchGroups = std::array<Expression const*, 8>;
 
 	Rules();
 
@@ -69,13 +76,23 @@ public:
 private:
 	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
 	void addRule(SimplificationRule<Pattern> const& _rule);
+	/// Appends @a _expr at depth @a _depth and its arguments up to the depth of the
+	/// deepest pattern to m_terms in pre-order.
+	void flatten(Expression const& _expr, ExpressionClasses const& _classes, unsigned _depth);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
+	MatchGroups m_matchGroups{};
 	/// Pattern to match, replacement to be applied and flag indicating whether
-	/// the replacement might remove some elements (except constants).
-	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	/// the replacement might remove some elements (except constants), in the
+	/// order they are tried.
+	std::vector<SimplificationRule<Pattern>> m_rules;
+	RuleTree m_tree;
+	/// Depth of the deepest pattern.
+	unsigned m_depth = 0;
+	/// Buffers reused by findFirstMatch.
+	std::vector<RuleTree::Term> m_terms;
+	std::vector<size_t> m_candidates;
 };
 
 /**
@@ -106,9 +123,12 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, Rules::MatchGroups& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
+	/// Appends the labels of this pattern and its arguments in pre-order to @a _labels.
+	/// @returns the depth of the pattern.
+	unsigned appendTreeLabels(std::vector<std::optional<RuleTreeLabel>>& _labels) const;
 
 	AssemblyItem toAssemblyItem(langutil::SourceLocation const& _location) const;
 	std::vector<Pattern> arguments() const { return m_arguments; }
@@ -116,7 +136,7 @@ public:
 	/// @returns the id of the matched expression if this pattern is part of a match group.
 	Id id() const { return matchGroupValue().id; }
 	/// @returns the data of the matched expression if this pattern is part of a match group.
-	u256 const& d() const { return matchGroupValue().item->data(); }
+	u256 d() const { return matchGroupValue().item->data(); }
 
 	std::string toString() const;
 
@@ -138,7 +158,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	Rules::MatchGroups* m_matchGroups = nullptr;
 };
 
 /**
@@ -240,7 +240,9 @@ BOOST_STATIC_ASSERT(TokenTraits::count() <= 0x100);
 
 Token Scanner::next()
 {
-	m_currentToken = m_nextToken;
+	// The look-ahead token is swapped in instead of copied, scanToken overwrites all of
+	// its fields and the literal buffers are reused.
+	swap(m_currentToken, m_nextToken);
 	m_skippedComment = m_nextSkippedComment;
 	scanToken();
 
@@ -913,11 +915,12 @@ Token Scanner::scanNumber(char _charSeen)
 tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 {
 	solAssert(isIdentifierStart(m_char), "");
-	LiteralScope literal(this, LITERAL_TYPE_STRING);
-	addLiteralCharAndAdvance();
+	// Identifiers are copied from the source in one go.
+	int start = sourcePos();
+	advance();
 	// Scan the rest of the identifier characters.
 	while (isIdentifierPart(m_char) || (m_char == '.' && m_supportPeriodInIdentifier))
-		addLiteralCharAndAdvance();
-	literal.complete();
+		advance();
+	m_nextToken.literal.assign(source(), start, sourcePos() - start);
 	return TokenTraits::fromIdentifierOrKeyword(m_nextToken.literal);
 }
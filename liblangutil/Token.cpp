@@ -43,6 +43,8 @@
 #include <liblangutil/Token.h>
 #include <boost/range/iterator_range.hpp>
 #include <map>
+#include <string_view>
+#include <unordered_map>
 
 using namespace std;
 
@@ -137,13 +139,14 @@ int parseSize(string::const_iterator _begin, string::const_iterator _end)
 	}
 }
 
-static Token keywordByName(string const& _name)
+static Token keywordByName(string_view _name)
 {
 	// The following macros are used inside TOKEN_LIST and cause non-keyword tokens to be ignored
 	// and keywords to be put inside the keywords variable.
+	// Identifiers are looked up for each token, so the keywords are hashed.
 #define KEYWORD(name, string, precedence) {string, Token::name},
 #define TOKEN(name, string, precedence)
-	static map<string, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
+	static unordered_map<string_view, Token> const keywords({TOKEN_LIST(TOKEN, KEYWORD)});
 #undef KEYWORD
 #undef TOKEN
 	auto it = keywords.find(_name);
@@ -155,7 +158,7 @@ tuple<Token, unsigned int, unsigned int> fromIdentifierOrKeyword(string const& _
 	auto positionM = find_if(_literal.begin(), _literal.end(), ::isdigit);
 	if (positionM != _literal.end())
 	{
-		string baseType(_literal.begin(), positionM);
+		string_view baseType(_literal.data(), size_t(positionM - _literal.begin()));
 		auto positionX = find_if_not(positionM, _literal.end(), ::isdigit);
 		int m = parseSize(positionM, positionX);
 		Token keyword = keywordByName(baseType);
@@ -35,29 +35,15 @@ using namespace std;
 using namespace dev;
 using namespace dev::solidity;
 
-class IDDispenser
-{
-public:
-	static size_t next() { return ++instance(); }
-	static void reset() { instance() = 0; }
-private:
-	static size_t& instance()
-	{
-		static IDDispenser dispenser;
-		return dispenser.id;
-	}
-	size_t id = 0;
-};
-
 ASTNode::ASTNode(SourceLocation const& _location):
-	m_id(IDDispenser::next()),
+	m_id(CurrentInstance<IDDispenser>::get().next()),
 	m_location(_location)
 {
 }
 
 void ASTNode::resetID()
 {
-	IDDispenser::reset();
+	CurrentInstance<IDDispenser>::get().reset();
 }
 
 ASTAnnotation& ASTNode::annotation() const
@@ -30,6 +30,7 @@
 
 #include <liblangutil/SourceLocation.h>
 #include <libevmasm/Instruction.h>
+#include <libdevcore/CurrentInstance.h>
 #include <libdevcore/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
@@ -56,6 +57,19 @@ class ASTVisitor;
 class ASTConstVisitor;
 
 
+/**
+ * Source of the AST node IDs of a compilation run. The AST nodes take their IDs
+ * from the dispenser that is current on the constructing thread.
+ */
+class IDDispenser
+{
+public:
+	size_t next() { return ++m_id; }
+	void reset() { m_id = 0; }
+private:
+	size_t m_id = 0;
+};
+
 /**
  * The root (abstract) class of the AST inheritance tree.
  * It is possible to traverse all direct and indirect children of an AST node by calling
@@ -71,7 +85,7 @@ public:
 
 	/// @returns an identifier of this AST node that is unique for a single compilation run.
 	size_t id() const { return m_id; }
-	/// Resets the global ID counter. This invalidates all previous IDs.
+	/// Resets the ID counter of the current IDDispenser. This invalidates all previous IDs.
 	static void resetID();
 
 	virtual void accept(ASTVisitor& _visitor) = 0;
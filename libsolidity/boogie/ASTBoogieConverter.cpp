@@ -465,6 +465,13 @@ void ASTBoogieConverter::processSpecificationExpression(ASTPointer<Expression> e
 
 bool ASTBoogieConverter::parseExpr(string exprStr, ASTNode const& _node, ASTNode const* _scope, BoogieContext::DocTagExpr& result)
 {
+	// Annotations converted earlier in the same context are reused
+	if (auto cached = m_context.cachedDocTagExpr(exprStr, _scope, false))
+	{
+		result = *cached;
+		return true;
+	}
+
 	// We temporarily replace the error reporter in the context, because the locations
 	// are pointing to positions in the docstring
 	ErrorList errorList;
@@ -511,11 +518,20 @@ bool ASTBoogieConverter::parseExpr(string exprStr, ASTNode const& _node, ASTNode
 	{
 		m_context.reportWarning(&_node, "Warning(s) while translating annotation for node");
 	}
+	else
+		m_context.cacheDocTagExpr(exprStr, _scope, false, result);
 	return true;
 }
 
 bool ASTBoogieConverter::parseSpecificationCasesExpr(string exprStr, ASTNode const& _node, ASTNode const* _scope, BoogieContext::DocTagExpr& result)
 {
+	// Annotations converted earlier in the same context are reused
+	if (auto cached = m_context.cachedDocTagExpr(exprStr, _scope, true))
+	{
+		result = *cached;
+		return true;
+	}
+
 	// We temporarily replace the error reporter in the context, because the locations
 	// are pointing to positions in the docstring
 	ErrorList errorList;
@@ -608,6 +624,8 @@ bool ASTBoogieConverter::parseSpecificationCasesExpr(string exprStr, ASTNode con
 	{
 		m_context.reportWarning(&_node, "Warning(s) while translating annotation for node");
 	}
+	else
+		m_context.cacheDocTagExpr(exprStr, _scope, true, result);
 	return true;
 }
 
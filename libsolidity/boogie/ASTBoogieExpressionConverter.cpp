@@ -1627,5 +1627,13 @@ bool ASTBoogieExpressionConverter::visitNode(ASTNode const&)
 	return true;
 }
 
+void ASTBoogieExpressionConverter::endVisitNode(ASTNode const&)
+{
+	// Share the result with structurally equal expressions converted before. As
+	// subexpressions are visited first, they are already shared at this point.
+	if (m_currentExpr)
+		m_currentExpr = m_context.intern(m_currentExpr);
+}
+
 }
 }
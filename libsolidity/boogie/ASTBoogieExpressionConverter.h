@@ -111,6 +111,7 @@ public:
 	bool visit(Literal const& _node) override;
 
 	bool visitNode(ASTNode const&) override;
+	void endVisitNode(ASTNode const&) override;
 
 };
 
@@ -39,7 +39,7 @@ Attr::Ref Attr::attr(std::string s, std::string v, int i, int j)
 	return attr(s, {Expr::stringlit(v), Expr::intlit((long) i), Expr::intlit((long) j)});
 }
 
-std::ostream& operator<<(std::ostream& os, Attr::Ref a)
+std::ostream& operator<<(std::ostream& os, Attr::Ref const& a)
 {
 	a->print(os);
 	return os;
@@ -67,6 +67,12 @@ void Attr::print(std::ostream& os) const
 	os << "}";
 }
 
+void Attr::collectSymbols(std::set<std::string>& symbols) const
+{
+	for (auto const& v: vals)
+		v->collectSymbols(symbols);
+}
+
 Specification::Specification(ExprRef e, std::vector<Attr::Ref> const& ax)
 : expr(e), attrs(ax)
 {
@@ -81,6 +87,13 @@ void Specification::print(std::ostream& os, std::string kind) const
 	os << expr << ";\n";
 }
 
+void Specification::collectSymbols(std::set<std::string>& symbols) const
+{
+	expr->collectSymbols(symbols);
+	for (auto const& a: attrs)
+		a->collectSymbols(symbols);
+}
+
 Specification::Ref Specification::spec(ExprRef e, std::vector<Attr::Ref> const& ax){
 	return std::make_shared<Specification const>(e, ax);
 }
@@ -26,7 +26,8 @@ public:
 
 	Attr(std::string n, std::vector<ExprRef> const& vs) : name(n), vals(vs) {}
 	void print(std::ostream& os) const;
-	std::string getName() const { return name; }
+	void collectSymbols(std::set<std::string>& symbols) const;
+	std::string const& getName() const { return name; }
 
 	static Ref attr(std::string s);
 	static Ref attr(std::string s, std::string v);
@@ -36,6 +37,8 @@ public:
 	static Ref attr(std::string s, std::vector<ExprRef> const& vs);
 };
 
+std::ostream& operator<<(std::ostream& os, Attr::Ref const& a);
+
 class Specification {
 	ExprRef expr;
 	std::vector<Attr::Ref> attrs;
@@ -44,8 +47,10 @@ public:
 	using Ref = std::shared_ptr<Specification const>;
 
 	Specification(ExprRef e, std::vector<Attr::Ref> const& ax);
+	ExprRef const& getExpr() const { return expr; }
 
 	void print(std::ostream& os, std::string kind) const;
+	void collectSymbols(std::set<std::string>& symbols) const;
 	static Ref spec(ExprRef e, std::vector<Attr::Ref> const& ax);
 	static Ref spec(ExprRef e);
 };
@@ -65,16 +70,20 @@ public:
 };
 
 template<class T>
-void print_seq(std::ostream& os, std::vector<T> const& ts, std::string init, std::string sep, std::string term)
+void print_seq(std::ostream& os, std::vector<T> const& ts, std::string const& init, std::string const& sep, std::string const& term)
 {
 	os << init;
 	for (auto i = ts.begin(); i != ts.end(); ++i)
-		os << (i == ts.begin() ? "" : sep) << *i;
+	{
+		if (i != ts.begin())
+			os << sep;
+		os << *i;
+	}
 	os << term;
 }
 
 template<class T>
-void print_seq(std::ostream& os, std::vector<T> const& ts, std::string sep)
+void print_seq(std::ostream& os, std::vector<T> const& ts, std::string const& sep)
 {
 	print_seq<T>(os, ts, "", sep, "");
 }
@@ -86,16 +95,20 @@ void print_seq(std::ostream& os, std::vector<T> const& ts)
 }
 
 template<class T, class C>
-void print_set(std::ostream& os, std::set<T,C> const& ts, std::string init, std::string sep, std::string term)
+void print_set(std::ostream& os, std::set<T,C> const& ts, std::string const& init, std::string const& sep, std::string const& term)
 {
 	os << init;
 	for (typename std::set<T,C>::const_iterator i = ts.begin(); i != ts.end(); ++i)
-		os << (i == ts.begin() ? "" : sep) << *i;
+	{
+		if (i != ts.begin())
+			os << sep;
+		os << *i;
+	}
 	os << term;
 }
 
 template<class T, class C>
-void print_set(std::ostream& os, std::set<T,C> const& ts, std::string sep)
+void print_set(std::ostream& os, std::set<T,C> const& ts, std::string const& sep)
 {
 	print_set<T,C>(os, ts, "", sep, "");
 }
@@ -4,7 +4,6 @@
 #include <libsolidity/boogie/BoogieAst.h>
 #include <libsolidity/boogie/BoogieAstDecl.h>
 #include <liblangutil/Exceptions.h>
-#include <sstream>
 #include <iostream>
 #include <boost/algorithm/string/predicate.hpp>
 
@@ -93,6 +92,14 @@ Decl::Ref Decl::comment(std::string name, std::string str)
 	return std::make_shared<CommentDecl>(name, str);
 }
 
+bool Decl::hasAttr(std::string attrName) const
+{
+	for (auto const& a: attrs)
+		if (a->getName() == attrName)
+			return true;
+	return false;
+}
+
 DataTypeDecl::DataTypeDecl(std::string n, std::string t, std::vector<AttrRef> const& ax, std::vector<Binding> members)
 		: TypeDecl(n, t, ax, "|T@" + n + "|"), members(members) { attrs.push_back(Attr::attr("datatype")); }
 
@@ -102,13 +109,13 @@ std::ostream& operator<<(std::ostream& os, Decl& d)
 	return os;
 }
 
-std::ostream& operator<<(std::ostream& os, Decl::Ref d)
+std::ostream& operator<<(std::ostream& os, Decl::Ref const& d)
 {
 	d->print(os);
 	return os;
 }
 
-std::ostream& operator<<(std::ostream& os, Decl::ConstRef d)
+std::ostream& operator<<(std::ostream& os, Decl::ConstRef const& d)
 {
 	d->print(os);
 	return os;
@@ -160,9 +167,13 @@ void FuncDecl::print(std::ostream& os) const
 	os << name << "(";
 	for (auto P = params.begin(), E = params.end(); P != E; ++P)
 	{
-		std::stringstream pname;
-		pname << *(P->id);
-		os << (P == params.begin() ? "" : ", ") << (pname.str() != "" ? pname.str() + ": " : "") << P->type->getName();
+		if (P != params.begin())
+			os << ", ";
+		// Parameters can be anonymous (empty identifier)
+		auto id = std::dynamic_pointer_cast<VarExpr const>(P->id);
+		if (!id || !id->getName().empty())
+			os << P->id << ": ";
+		os << P->type->getName();
 	}
 	os << ") returns (" << type->getName() << ")";
 	if (body)
@@ -180,6 +191,27 @@ void VarDecl::print(std::ostream& os) const
 }
 
 void ProcDecl::print(std::ostream& os) const
+{
+	printHeader(os, !blocks.empty());
+	if (blocks.size() > 0)
+	{
+		os << "\n";
+		os << "{" << "\n";
+		if (decls.size() > 0)
+			print_seq(os, decls, "	", "\n	", "\n");
+		print_seq(os, blocks, "\n");
+		os << "\n" << "}";
+	}
+	os << "\n";
+}
+
+void ProcDecl::printDeclaration(std::ostream& os) const
+{
+	printHeader(os, false);
+	os << "\n";
+}
+
+void ProcDecl::printHeader(std::ostream& os, bool withBody) const
 {
 	os << "procedure ";
 	if (attrs.size() > 0)
@@ -196,7 +228,7 @@ void ProcDecl::print(std::ostream& os) const
 			os << (R == rets.begin() ? "" : ", ") << R->id << ": " << R->type->getName();
 		os << ")";
 	}
-	if (blocks.size() == 0)
+	if (!withBody)
 		os << ";";
 
 	if (mods.size() > 0)
@@ -214,16 +246,6 @@ void ProcDecl::print(std::ostream& os) const
 		os << "\n";
 		for (auto ens: ensures) ens->print(os, "ensures");
 	}
-	if (blocks.size() > 0)
-	{
-		os << "\n";
-		os << "{" << "\n";
-		if (decls.size() > 0)
-			print_seq(os, decls, "	", "\n	", "\n");
-		print_seq(os, blocks, "\n");
-		os << "\n" << "}";
-	}
-	os << "\n";
 }
 
 void CodeDecl::print(std::ostream& os) const
@@ -242,6 +264,84 @@ void CommentDecl::print(std::ostream& os) const
 	}
 }
 
+void Decl::collectSymbols(std::set<std::string>& symbols) const
+{
+	for (auto const& a: attrs)
+		a->collectSymbols(symbols);
+}
+
+void TypeDecl::collectSymbols(std::set<std::string>& symbols) const
+{
+	Decl::collectSymbols(symbols);
+	collectTypeSymbols(alias, symbols);
+}
+
+void DataTypeDecl::collectSymbols(std::set<std::string>& symbols) const
+{
+	TypeDecl::collectSymbols(symbols);
+	for (auto const& m: members)
+		collectTypeSymbols(m.type->getName(), symbols);
+}
+
+void AxiomDecl::collectSymbols(std::set<std::string>& symbols) const
+{
+	Decl::collectSymbols(symbols);
+	expr->collectSymbols(symbols);
+}
+
+void ConstDecl::collectSymbols(std::set<std::string>& symbols) const
+{
+	Decl::collectSymbols(symbols);
+	collectTypeSymbols(type->getName(), symbols);
+}
+
+void FuncDecl::collectSymbols(std::set<std::string>& symbols) const
+{
+	Decl::collectSymbols(symbols);
+	for (auto const& p: params)
+		collectTypeSymbols(p.type->getName(), symbols);
+	collectTypeSymbols(type->getName(), symbols);
+	if (body)
+		body->collectSymbols(symbols);
+}
+
+void VarDecl::collectSymbols(std::set<std::string>& symbols) const
+{
+	Decl::collectSymbols(symbols);
+	collectTypeSymbols(type->getName(), symbols);
+}
+
+void ProcDecl::collectDeclarationSymbols(std::set<std::string>& symbols) const
+{
+	Decl::collectSymbols(symbols);
+	for (auto const& p: params)
+		collectTypeSymbols(p.type->getName(), symbols);
+	for (auto const& r: rets)
+		collectTypeSymbols(r.type->getName(), symbols);
+	symbols.insert(mods.begin(), mods.end());
+	for (auto const& req: requires)
+		req->collectSymbols(symbols);
+	for (auto const& ens: ensures)
+		ens->collectSymbols(symbols);
+}
+
+void ProcDecl::collectSymbols(std::set<std::string>& symbols) const
+{
+	collectDeclarationSymbols(symbols);
+	for (auto const& d: decls)
+		d->collectSymbols(symbols);
+	for (auto const& b: blocks)
+		b->collectSymbols(symbols);
+}
+
+ProcDeclRef ProcDecl::withoutBody() const
+{
+	auto proc = std::make_shared<ProcDecl>(*this);
+	proc->decls.clear();
+	proc->blocks.clear();
+	return proc;
+}
+
 int TypeDecl::cmp(TypeDecl const& td) const
 {
 	return std::strcmp(smttype.c_str(), td.smttype.c_str());
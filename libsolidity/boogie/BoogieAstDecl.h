@@ -80,11 +80,15 @@ public:
 
 	virtual ~Decl() {}
 	virtual void print(std::ostream& os) const = 0;
+	/** Collects the names (variables, functions, procedures, types) the declaration refers to */
+	virtual void collectSymbols(std::set<std::string>& symbols) const;
 	unsigned getId() const { return id; }
-	std::string getName() const { return name; }
+	std::string const& getName() const { return name; }
 	Expr::Ref getRefTo() const { return Expr::id(name); }
 	void addAttr(AttrRef a) { attrs.push_back(a); }
 	void addAttrs(std::vector<AttrRef> const& ax) { for (auto a: ax) addAttr(a); }
+	std::vector<AttrRef> const& getAttrs() const { return attrs; }
+	bool hasAttr(std::string attrName) const;
 
 	static TypeDeclRef elementarytype(std::string name);
 	static TypeDeclRef aliasedtype(std::string name, TypeDeclRef alias);
@@ -121,8 +125,9 @@ public:
 		: Decl(TYPE, n, ax), alias(a), smttype(smt) {}
 	std::string getAlias() const { return alias; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	static bool classof(Decl::ConstRef D) { return D->getKind() == TYPE; }
-	std::string getSmtType() const { return smttype; }
+	std::string const& getSmtType() const { return smttype; }
 	int cmp(TypeDecl const& td) const;
 };
 
@@ -132,6 +137,7 @@ public:
 	DataTypeDecl(std::string n, std::string t, std::vector<AttrRef> const& ax, std::vector<Binding> members);
 	std::vector<Binding> getMembers() const { return members; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 };
 
 
@@ -140,7 +146,9 @@ class AxiomDecl : public Decl {
 	static int uniqueId;
 public:
 	AxiomDecl(std::string n, Expr::Ref e) : Decl(AXIOM, n, {}), expr(e) {}
+	Expr::Ref const& getExpr() const { return expr; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	static bool classof(Decl::ConstRef D) { return D->getKind() == AXIOM; }
 };
 
@@ -150,7 +158,10 @@ class ConstDecl : public Decl {
 public:
 	ConstDecl(std::string n, TypeDeclRef t, std::vector<AttrRef> const& ax, bool u)
 		: Decl(CONSTANT, n, ax), type(t), unique(u) {}
+	TypeDeclRef getType() const { return type; }
+	bool isUnique() const { return unique; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	static bool classof(Decl::ConstRef D) { return D->getKind() == CONSTANT; }
 };
 
@@ -162,8 +173,12 @@ public:
 	FuncDecl(std::string n, std::vector<AttrRef> const& ax, std::vector<Binding> const& ps,
 			TypeDeclRef t, Expr::Ref b)
 		: Decl(FUNCTION, n, ax), params(ps), type(t), body(b) {}
+	TypeDeclRef getType() const { return type; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	static bool classof(Decl::ConstRef D) { return D->getKind() == FUNCTION; }
+	std::vector<Binding> const& getParams() const { return params; }
+	Expr::Ref const& getBody() const { return body; }
 };
 
 class VarDecl : public Decl {
@@ -171,6 +186,7 @@ class VarDecl : public Decl {
 public:
 	VarDecl(std::string n, TypeDeclRef t) : Decl(VARIABLE, n, {}), type(t) {}
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	static bool classof(Decl::ConstRef D) { return D->getKind() == VARIABLE; }
 	TypeDeclRef getType() const { return type; }
 };
@@ -206,8 +222,19 @@ public:
 	spec_iterator ensures_end() { return ensures.end(); }
 	SpecificationList& getEnsures() { return ensures; }
 
+	bool hasBody() const { return !blocks.empty(); }
+
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	/** Prints only the signature and the specification, without the implementation */
+	void printDeclaration(std::ostream& os) const;
+	/** Collects the names referred to by the signature and the specification */
+	void collectDeclarationSymbols(std::set<std::string>& symbols) const;
+	/** Creates a copy of the procedure without the implementation */
+	ProcDeclRef withoutBody() const;
 	static bool classof(Decl::ConstRef D) { return D->getKind() == PROCEDURE; }
+private:
+	void printHeader(std::ostream& os, bool withBody) const;
 };
 
 class CodeDecl : public Decl {
@@ -227,7 +254,7 @@ public:
 };
 
 std::ostream& operator<<(std::ostream& os, Decl& e);
-std::ostream& operator<<(std::ostream& os, Decl::Ref e);
-std::ostream& operator<<(std::ostream& os, Decl::ConstRef e);
+std::ostream& operator<<(std::ostream& os, Decl::Ref const& e);
+std::ostream& operator<<(std::ostream& os, Decl::ConstRef const& e);
 
 }
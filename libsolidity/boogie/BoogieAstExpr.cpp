@@ -5,6 +5,7 @@
 #include <libsolidity/boogie/BoogieAstDecl.h>
 #include <libsolidity/boogie/BoogieAstExpr.h>
 #include <liblangutil/Exceptions.h>
+#include <boost/functional/hash.hpp>
 #include <sstream>
 #include <iostream>
 
@@ -273,6 +274,11 @@ Expr::Ref Expr::tuple(std::vector<Ref> const& elems)
 	return std::make_shared<TupleExpr const>(elems);
 }
 
+Expr::Ref Expr::let(std::string var, Ref value, Ref body)
+{
+	return std::make_shared<LetExpr const>(var, value, body);
+}
+
 Expr::Ref Expr::selectToUpdate(Expr::Ref sel, Expr::Ref value)
 {
 	if (auto selExpr = std::dynamic_pointer_cast<SelExpr const>(sel))
@@ -292,7 +298,7 @@ std::ostream& operator<<(std::ostream& os, Expr const& e)
 	return os;
 }
 
-std::ostream& operator<<(std::ostream& os, Expr::Ref e)
+std::ostream& operator<<(std::ostream& os, Expr::Ref const& e)
 {
 	e->printBg(os);
 	return os;
@@ -496,6 +502,11 @@ void DtUpdExpr::printBg(std::ostream& os) const
 	os << ")";
 }
 
+void LetExpr::printBg(std::ostream& os) const
+{
+	os << "(var " << var << " := " << value << "; " << body << ")";
+}
+
 //
 // Substitution stuff
 //
@@ -642,6 +653,16 @@ Expr::Ref DtUpdExpr::substitute(Expr::Subst const& s) const
 	return std::make_shared<DtUpdExpr const>(base1, member, val1, constr, dt);
 }
 
+Expr::Ref LetExpr::substitute(Expr::Subst const& s) const
+{
+	Ref value1 = value->substitute(s);
+	// The bound variable is not substituted in the body
+	Expr::Subst s1(s);
+	s1.erase(var);
+	Ref body1 = body->substitute(s1);
+	return std::make_shared<LetExpr const>(var, value1, body1);
+}
+
 //
 // Containment
 //
@@ -781,13 +802,459 @@ bool DtUpdExpr::contains(std::string id) const
 	return false;
 }
 
+bool LetExpr::contains(std::string id) const
+{
+	if (value->contains(id))
+		return true;
+	return id != var && body->contains(id);
+}
+
+//
+// Symbols
+//
+
+void collectTypeSymbols(std::string const& typeName, std::set<std::string>& symbols)
+{
+	std::string current;
+	for (char c: typeName)
+	{
+		if (c == '[' || c == ']' || c == '<' || c == '>' || c == '(' || c == ')' || c == ',' || c == ' ')
+		{
+			if (!current.empty())
+				symbols.insert(current);
+			current.clear();
+		}
+		else
+			current += c;
+	}
+	if (!current.empty())
+		symbols.insert(current);
+}
+
+void ErrorExpr::collectSymbols(std::set<std::string>&) const
+{
+}
+
+void BinExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	lhs->collectSymbols(symbols);
+	rhs->collectSymbols(symbols);
+}
+
+void CondExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	cond->collectSymbols(symbols);
+	then->collectSymbols(symbols);
+	else_->collectSymbols(symbols);
+}
+
+void FunExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	symbols.insert(fun);
+	for (Ref a: args)
+		a->collectSymbols(symbols);
+}
+
+void BoolLit::collectSymbols(std::set<std::string>&) const
+{
+}
+
+void IntLit::collectSymbols(std::set<std::string>&) const
+{
+}
+
+void BvLit::collectSymbols(std::set<std::string>&) const
+{
+}
+
+void NegExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	expr->collectSymbols(symbols);
+}
+
+void NotExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	expr->collectSymbols(symbols);
+}
+
+void QuantExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	// Bound variables are over-approximated as free, which is harmless
+	for (Binding const& b: vars)
+		collectTypeSymbols(b.type->getName(), symbols);
+	expr->collectSymbols(symbols);
+}
+
+void ArrConstExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	collectTypeSymbols(arrType->getName(), symbols);
+	val->collectSymbols(symbols);
+}
+
+void ArrSelExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	base->collectSymbols(symbols);
+	idx->collectSymbols(symbols);
+}
+
+void ArrUpdExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	base->collectSymbols(symbols);
+	idx->collectSymbols(symbols);
+	val->collectSymbols(symbols);
+}
+
+void VarExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	symbols.insert(name);
+}
+
+void OldExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	expr->collectSymbols(symbols);
+}
+
+void TupleExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	for (Ref e: elems)
+		e->collectSymbols(symbols);
+}
+
+void StringLit::collectSymbols(std::set<std::string>&) const
+{
+}
+
+void DtSelExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	symbols.insert(constr->getName());
+	if (dt)
+		symbols.insert(dt->getName());
+	base->collectSymbols(symbols);
+}
+
+void DtUpdExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	symbols.insert(constr->getName());
+	if (dt)
+		symbols.insert(dt->getName());
+	base->collectSymbols(symbols);
+	val->collectSymbols(symbols);
+}
+
+void LetExpr::collectSymbols(std::set<std::string>& symbols) const
+{
+	value->collectSymbols(symbols);
+	std::set<std::string> bodySymbols;
+	body->collectSymbols(bodySymbols);
+	bodySymbols.erase(var);
+	symbols.insert(bodySymbols.begin(), bodySymbols.end());
+}
+
+//
+// Children
+//
+
+Expr::Ref Expr::withChildren(std::vector<Ref> const&) const
+{
+	solAssert(false, "Expression has no children");
+	return nullptr;
+}
+
+std::vector<Expr::Ref> BinExpr::getChildren() const
+{
+	return {lhs, rhs};
+}
+
+Expr::Ref BinExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 2, "");
+	return std::make_shared<BinExpr const>(op, children[0], children[1]);
+}
+
+std::vector<Expr::Ref> CondExpr::getChildren() const
+{
+	return {cond, then, else_};
+}
+
+Expr::Ref CondExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 3, "");
+	return std::make_shared<CondExpr const>(children[0], children[1], children[2]);
+}
+
+std::vector<Expr::Ref> FunExpr::getChildren() const
+{
+	return args;
+}
+
+Expr::Ref FunExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == args.size(), "");
+	return std::make_shared<FunExpr const>(fun, children);
+}
+
+std::vector<Expr::Ref> NegExpr::getChildren() const
+{
+	return {expr};
+}
+
+Expr::Ref NegExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 1, "");
+	return std::make_shared<NegExpr const>(children[0]);
+}
+
+std::vector<Expr::Ref> NotExpr::getChildren() const
+{
+	return {expr};
+}
+
+Expr::Ref NotExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 1, "");
+	return std::make_shared<NotExpr const>(children[0]);
+}
+
+std::vector<Expr::Ref> ArrConstExpr::getChildren() const
+{
+	return {val};
+}
+
+Expr::Ref ArrConstExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 1, "");
+	return std::make_shared<ArrConstExpr const>(arrType, children[0]);
+}
+
+std::vector<Expr::Ref> ArrSelExpr::getChildren() const
+{
+	return {base, idx};
+}
+
+Expr::Ref ArrSelExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 2, "");
+	return std::make_shared<ArrSelExpr const>(children[0], children[1]);
+}
+
+std::vector<Expr::Ref> ArrUpdExpr::getChildren() const
+{
+	return {base, idx, val};
+}
+
+Expr::Ref ArrUpdExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 3, "");
+	return std::make_shared<ArrUpdExpr const>(children[0], children[1], children[2]);
+}
+
+std::vector<Expr::Ref> DtSelExpr::getChildren() const
+{
+	return {base};
+}
+
+Expr::Ref DtSelExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 1, "");
+	return std::make_shared<DtSelExpr const>(children[0], member, constr, dt);
+}
+
+std::vector<Expr::Ref> DtUpdExpr::getChildren() const
+{
+	return {base, val};
+}
+
+Expr::Ref DtUpdExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == 2, "");
+	return std::make_shared<DtUpdExpr const>(children[0], member, children[1], constr, dt);
+}
+
+std::vector<Expr::Ref> TupleExpr::getChildren() const
+{
+	return elems;
+}
+
+Expr::Ref TupleExpr::withChildren(std::vector<Ref> const& children) const
+{
+	solAssert(children.size() == elems.size(), "");
+	return std::make_shared<TupleExpr const>(children);
+}
+
+//
+// Hashing
+//
+
+std::size_t Expr::hash() const
+{
+	if (m_hash == 0)
+	{
+		m_hash = computeHash();
+		boost::hash_combine(m_hash, static_cast<int>(kind()));
+		// 0 is reserved for hashes not computed yet
+		if (m_hash == 0)
+			m_hash = 1;
+	}
+	return m_hash;
+}
+
+namespace
+{
+
+std::size_t hashSeq(std::vector<Expr::Ref> const& exprs)
+{
+	std::size_t seed = exprs.size();
+	for (auto const& e: exprs)
+		boost::hash_combine(seed, e->hash());
+	return seed;
+}
+
+}
+
+std::size_t ErrorExpr::computeHash() const
+{
+	return 0;
+}
+
+std::size_t BinExpr::computeHash() const
+{
+	std::size_t seed = lhs->hash();
+	boost::hash_combine(seed, rhs->hash());
+	return seed;
+}
+
+std::size_t CondExpr::computeHash() const
+{
+	std::size_t seed = cond->hash();
+	boost::hash_combine(seed, then->hash());
+	boost::hash_combine(seed, else_->hash());
+	return seed;
+}
+
+std::size_t FunExpr::computeHash() const
+{
+	std::size_t seed = boost::hash_value(fun);
+	boost::hash_combine(seed, hashSeq(args));
+	return seed;
+}
+
+std::size_t BoolLit::computeHash() const
+{
+	return val ? 1 : 0;
+}
+
+std::size_t IntLit::computeHash() const
+{
+	return boost::hash<bigint>()(val);
+}
+
+std::size_t BvLit::computeHash() const
+{
+	std::size_t seed = boost::hash_value(val);
+	boost::hash_combine(seed, width);
+	return seed;
+}
+
+std::size_t NegExpr::computeHash() const
+{
+	return expr->hash();
+}
+
+std::size_t NotExpr::computeHash() const
+{
+	return expr->hash();
+}
+
+std::size_t QuantExpr::computeHash() const
+{
+	std::size_t seed = expr->hash();
+	for (auto const& var: vars)
+	{
+		boost::hash_combine(seed, var.id->hash());
+		boost::hash_combine(seed, var.type->getSmtType());
+	}
+	return seed;
+}
+
+std::size_t ArrConstExpr::computeHash() const
+{
+	std::size_t seed = boost::hash_value(arrType->getSmtType());
+	boost::hash_combine(seed, val->hash());
+	return seed;
+}
+
+std::size_t ArrSelExpr::computeHash() const
+{
+	std::size_t seed = base->hash();
+	boost::hash_combine(seed, idx->hash());
+	return seed;
+}
+
+std::size_t ArrUpdExpr::computeHash() const
+{
+	std::size_t seed = base->hash();
+	boost::hash_combine(seed, idx->hash());
+	boost::hash_combine(seed, val->hash());
+	return seed;
+}
+
+std::size_t VarExpr::computeHash() const
+{
+	return boost::hash_value(name);
+}
+
+std::size_t OldExpr::computeHash() const
+{
+	return expr->hash();
+}
+
+std::size_t TupleExpr::computeHash() const
+{
+	return hashSeq(elems);
+}
+
+std::size_t StringLit::computeHash() const
+{
+	return boost::hash_value(val);
+}
+
+// Constructors and datatypes are not part of the comparison, so they are not hashed either
+
+std::size_t DtSelExpr::computeHash() const
+{
+	std::size_t seed = boost::hash_value(member);
+	boost::hash_combine(seed, base->hash());
+	return seed;
+}
+
+std::size_t DtUpdExpr::computeHash() const
+{
+	std::size_t seed = boost::hash_value(member);
+	boost::hash_combine(seed, base->hash());
+	boost::hash_combine(seed, val->hash());
+	return seed;
+}
+
+std::size_t LetExpr::computeHash() const
+{
+	std::size_t seed = boost::hash_value(var);
+	boost::hash_combine(seed, value->hash());
+	boost::hash_combine(seed, body->hash());
+	return seed;
+}
+
+Expr::Ref ExprInterner::intern(Expr::Ref const& expr)
+{
+	return *m_exprs.insert(expr).first;
+}
+
 //
 // Comparison stuff
 //
 
 template<typename T>
 struct CmpHelper {
-	static int cmp(Expr::Ref e1, Expr::Ref e2)
+	static int cmp(Expr::Ref const& e1, Expr::Ref const& e2)
 	{
 		auto ptr1 = dynamic_cast<T const*>(e1.get());
 		solAssert(ptr1, "Wrong type");
@@ -797,8 +1264,12 @@ struct CmpHelper {
 	}
 };
 
-int Expr::cmp(Expr::Ref e1, Expr::Ref e2)
+int Expr::cmp(Expr::Ref const& e1, Expr::Ref const& e2)
 {
+	// Shared (e.g., interned) subexpressions
+	if (e1 == e2)
+		return 0;
+
 	if (e1->kind() != e2->kind())
 		return static_cast<int>(e1->kind()) - static_cast<int>(e2->kind());
 
@@ -844,6 +1315,7 @@ int Expr::cmp(Expr::Ref e1, Expr::Ref e2)
 	case Kind::OLD: return CmpHelper<OldExpr>::cmp(e1, e2);
 	case Kind::TUPLE: return CmpHelper<TupleExpr>::cmp(e1, e2);
 	case Kind::CONCAT: return CmpHelper<BinExpr>::cmp(e1, e2);
+	case Kind::LET: return CmpHelper<LetExpr>::cmp(e1, e2);
 	}
 
 	solAssert(false, "Unknown expression");
@@ -858,7 +1330,7 @@ Expr::Kind BinExpr::kind() const {
 	case Or: return Kind::OR;
 	case And: return Kind::AND;
 	case Eq: return Kind::EQ;
-	case Neq: return Kind::NEG;
+	case Neq: return Kind::NEQ;
 	case Lt: return Kind::LT;
 	case Gt: return Kind::GT;
 	case Lte: return Kind::LTE;
@@ -894,12 +1366,21 @@ int ErrorExpr::cmp(ErrorExpr const&) const
 int BinExpr::cmp(BinExpr const& e) const
 {
 	solAssert(op == e.op, "Must be same binary expression");
-	return Expr::cmp({lhs, rhs}, {e.lhs, e.rhs});
+	int cmp = Expr::cmp(lhs, e.lhs);
+	if (cmp != 0)
+		return cmp;
+	return Expr::cmp(rhs, e.rhs);
 }
 
 int CondExpr::cmp(CondExpr const& e) const
 {
-	return Expr::cmp({cond, then, else_}, {e.cond, e.then, e.else_});
+	int cmp = Expr::cmp(cond, e.cond);
+	if (cmp != 0)
+		return cmp;
+	cmp = Expr::cmp(then, e.then);
+	if (cmp != 0)
+		return cmp;
+	return Expr::cmp(else_, e.else_);
 }
 
 int FunExpr::cmp(FunExpr const& e) const
@@ -968,12 +1449,21 @@ int ArrConstExpr::cmp(ArrConstExpr const& e) const
 
 int ArrSelExpr::cmp(ArrSelExpr const& e) const
 {
-	return Expr::cmp({base, idx}, {e.base, e.idx});
+	int cmp = Expr::cmp(base, e.base);
+	if (cmp != 0)
+		return cmp;
+	return Expr::cmp(idx, e.idx);
 }
 
 int ArrUpdExpr::cmp(ArrUpdExpr const& e) const
 {
-	return Expr::cmp({base, idx, val}, {e.base, e.idx, e.val});
+	int cmp = Expr::cmp(base, e.base);
+	if (cmp != 0)
+		return cmp;
+	cmp = Expr::cmp(idx, e.idx);
+	if (cmp != 0)
+		return cmp;
+	return Expr::cmp(val, e.val);
 }
 
 int VarExpr::cmp(VarExpr const& e) const
@@ -1011,7 +1501,30 @@ int DtUpdExpr::cmp(DtUpdExpr const& e) const
 	int cmp = std::strcmp(member.c_str(), e.member.c_str());
 	if (cmp != 0)
 		return cmp;
-	return Expr::cmp({base, val}, {e.base, e.val});
+	cmp = Expr::cmp(base, e.base);
+	if (cmp != 0)
+		return cmp;
+	return Expr::cmp(val, e.val);
+}
+
+int LetExpr::cmp(LetExpr const& e) const
+{
+	int cmp = std::strcmp(var.c_str(), e.var.c_str());
+	if (cmp != 0)
+		return cmp;
+	cmp = Expr::cmp(value, e.value);
+	if (cmp != 0)
+		return cmp;
+	return Expr::cmp(body, e.body);
+}
+
+bool Expr::equals(Ref const& e1, Ref const& e2)
+{
+	if (e1 == e2)
+		return true;
+	if (e1->hash() != e2->hash())
+		return false;
+	return cmp(e1, e2) == 0;
 }
 
 int Expr::cmp(std::vector<Ref> const& l1, std::vector<Ref> const& l2)
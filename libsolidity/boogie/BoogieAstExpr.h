@@ -8,6 +8,7 @@
 #include <vector>
 #include <memory>
 #include <set>
+#include <unordered_set>
 #include <libdevcore/Common.h>
 
 namespace boogie
@@ -37,12 +38,22 @@ public:
 	/** Comparison for references */
 	struct RefCompare
 	{
-		bool operator() (Ref r1, Ref r2) const
+		bool operator() (Ref const& r1, Ref const& r2) const
 		{
 			return Expr::cmp(r1, r2) < 0;
 		}
 	};
 
+	/** Structural hashing and equality for references (for unordered containers) */
+	struct RefHash
+	{
+		std::size_t operator() (Ref const& r) const { return r->hash(); }
+	};
+	struct RefEqual
+	{
+		bool operator() (Ref const& r1, Ref const& r2) const { return Expr::equals(r1, r2); }
+	};
+
 	/** Sets of references */
 	using RefSet = std::set<Ref, RefCompare>;
 
@@ -98,7 +109,8 @@ public:
 		DATATYPE_UPDATE,
 		OLD,
 		TUPLE,
-		CONCAT
+		CONCAT,
+		LET
 	};
 
 	/** Get the kind of the expression */
@@ -110,12 +122,29 @@ public:
 	/** Check whether the expression contains the given variable */
 	virtual bool contains(std::string id) const = 0;
 
+	/** Collects the names (variables, functions, types) the expression refers to */
+	virtual void collectSymbols(std::set<std::string>& symbols) const = 0;
+
+	/**
+	 * Subexpressions that are evaluated in the same context as the expression.
+	 * Subexpressions referring to bound variables (quantifiers, let) or to a
+	 * different state (old) are not included.
+	 */
+	virtual std::vector<Ref> getChildren() const { return {}; }
+	/** Creates a copy of the expression with the children (see getChildren) replaced */
+	virtual Ref withChildren(std::vector<Ref> const& children) const;
+
 	bool isError() const { return kind() == Kind::ERROR; }
 
+	/** Structural hash of the expression (structurally equal expressions have equal hashes) */
+	std::size_t hash() const;
+
 	/** Comparison of expressions */
-	static int cmp(Ref e1, Ref e2);
+	static int cmp(Ref const& e1, Ref const& e2);
 	/** Lexicographic comparison of *same size* vectors of expressions */
 	static int cmp(std::vector<Ref> const& l1, std::vector<Ref> const& l2);
+	/** Structural equality of expressions (using the hashes to exit early) */
+	static bool equals(Ref const& e1, Ref const& e2);
 
 	/** Special expression to denote errors */
 	static Ref error();
@@ -167,8 +196,16 @@ public:
 	static Ref dtupd(Ref base, std::string mem, Ref val, FuncDeclRef constr, DataTypeDeclRef dt);
 	static Ref old(Ref expr);
 	static Ref tuple(std::vector<Ref> const& exprs);
+	static Ref let(std::string var, Ref value, Ref body);
 
 	static Ref selectToUpdate(Ref sel, Ref value);
+
+protected:
+	/** Computes the structural hash (called once, the result is cached by hash()) */
+	virtual std::size_t computeHash() const = 0;
+
+private:
+	mutable std::size_t m_hash = 0; // Cached hash, 0 if not computed yet
 };
 
 struct Binding
@@ -177,6 +214,24 @@ struct Binding
 	TypeDeclRef type;
 };
 
+/**
+ * Interns expressions: structurally equal expressions are mapped to a single
+ * shared node. Interning expressions bottom-up (children first) turns the
+ * expressions into a DAG where comparison of equal subexpressions is O(1).
+ */
+class ExprInterner
+{
+public:
+	/** Returns the node structurally equal to expr (expr itself if it is new) */
+	Expr::Ref intern(Expr::Ref const& expr);
+
+private:
+	std::unordered_set<Expr::Ref, Expr::RefHash, Expr::RefEqual> m_exprs;
+};
+
+/** Collects the names of the types occurring in a type name (e.g., [address_t]int) */
+void collectTypeSymbols(std::string const& typeName, std::set<std::string>& symbols);
+
 class ErrorExpr : public Expr
 {
 public:
@@ -184,7 +239,9 @@ public:
 	Kind kind() const override { return Kind::ERROR; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(ErrorExpr const& e) const;
+	std::size_t computeHash() const override;
 };
 
 class BinExpr : public Expr
@@ -201,11 +258,18 @@ private:
 	Expr::Ref rhs;
 public:
 	BinExpr(BinaryOperator const op, Expr::Ref lhs, Expr::Ref rhs) : op(op), lhs(lhs), rhs(rhs) {}
+	BinaryOperator getOp() const { return op; }
+	Expr::Ref const& getLhs() const { return lhs; }
+	Expr::Ref const& getRhs() const { return rhs; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override;
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(BinExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 };
 
 class CondExpr : public Expr {
@@ -218,7 +282,11 @@ public:
 	Kind kind() const override { return Kind::COND; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(CondExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 
 	Expr::Ref getCond() const { return cond; }
 	Expr::Ref getThen() const { return then; }
@@ -230,22 +298,31 @@ class FunExpr : public Expr {
 	std::vector<Ref> args;
 public:
 	FunExpr(std::string f, std::vector<Ref> const& args) : fun(f), args(args) {}
+	std::string const& getName() const { return fun; }
+	std::vector<Ref> const& getArgs() const { return args; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::FN; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(FunExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 };
 
 class BoolLit : public Expr {
 	bool val;
 public:
 	BoolLit(bool b) : val(b) {}
+	bool getVal() const { return val; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::LIT_BOOL; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(BoolLit const& e) const;
+	std::size_t computeHash() const override;
 };
 
 class IntLit : public Expr {
@@ -260,7 +337,9 @@ public:
 	Kind kind() const override { return Kind::LIT_INT; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(IntLit const& e) const;
+	std::size_t computeHash() const override;
 };
 
 class BvLit : public Expr {
@@ -279,7 +358,9 @@ public:
 	Kind kind() const override { return Kind::LIT_BV; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(BvLit const& e) const;
+	std::size_t computeHash() const override;
 };
 
 class StringLit : public Expr {
@@ -290,29 +371,41 @@ public:
 	Kind kind() const override { return Kind::LIT_STRING; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(StringLit const& e) const;
+	std::size_t computeHash() const override;
 };
 
 class NegExpr : public Expr {
 	Expr::Ref expr;
 public:
 	NegExpr(Expr::Ref expr) : expr(expr) {}
+	Expr::Ref const& getExpr() const { return expr; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::NEG; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(NegExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 };
 
 class NotExpr : public Expr {
 	Expr::Ref expr;
 public:
 	NotExpr(Expr::Ref expr) : expr(expr) {}
+	Expr::Ref const& getExpr() const { return expr; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::NOT; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(NotExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 };
 
 class QuantExpr : public Expr {
@@ -328,7 +421,9 @@ public:
 	Kind kind() const override;
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(QuantExpr const& e) const;
+	std::size_t computeHash() const override;
 };
 
 class SelExpr : public Expr {
@@ -355,11 +450,17 @@ class ArrConstExpr : public Expr {
 	Ref val;
 public:
 	ArrConstExpr(TypeDeclRef arrType, Ref val) : arrType(arrType), val(val) {}
+	TypeDeclRef getType() const { return arrType; }
+	Ref const& getVal() const { return val; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::ARRAY_CONST; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(ArrConstExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 };
 
 class ArrSelExpr : public SelExpr {
@@ -371,7 +472,11 @@ public:
 	Kind kind() const override { return Kind::ARRAY_SELECT; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(ArrSelExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 	Ref toUpdate(Ref value) const override { return Expr::arrupd(base, idx, value); }
 	Ref replaceBase(Ref newBase) const override { return Expr::arrsel(newBase, idx); }
 };
@@ -381,11 +486,17 @@ class ArrUpdExpr : public UpdExpr {
 public:
 	ArrUpdExpr(Ref base, Ref idx, Ref val)
 		: UpdExpr(base, val), idx(idx) {}
+	Ref const& getIdx() const { return idx; }
+	Ref const& getVal() const { return val; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::ARRAY_UPDATE; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(ArrUpdExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 };
 
 class DtSelExpr : public SelExpr {
@@ -402,7 +513,11 @@ public:
 	Kind kind() const override { return Kind::DATATYPE_SELECT; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(DtSelExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 	Ref toUpdate(Ref v) const override { return Expr::dtupd(base, member, v, constr, dt); }
 	Ref replaceBase(Ref b) const override { return Expr::dtsel(b, member, constr, dt); }
 };
@@ -422,30 +537,39 @@ public:
 	Kind kind() const override { return Kind::DATATYPE_UPDATE; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(DtUpdExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
 };
 
 class VarExpr : public Expr {
 	std::string name;
 public:
 	VarExpr(std::string name) : name(name) {}
-	std::string getName() const { return name; }
+	std::string const& getName() const { return name; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::VARIABLE; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(VarExpr const& e) const;
+	std::size_t computeHash() const override;
 };
 
 class OldExpr : public Expr {
 	Ref expr;
 public:
 	OldExpr(Ref expr) : expr(expr) {}
+	Ref const& getExpr() const { return expr; }
 	void printBg(std::ostream& os) const override;
 	Kind kind() const override { return Kind::OLD; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(OldExpr const& e) const;
+	std::size_t computeHash() const override;
 };
 
 class TupleExpr : public Expr {
@@ -457,10 +581,33 @@ public:
 	Kind kind() const override { return Kind::TUPLE; }
 	Ref substitute(Subst const& s) const override;
 	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	int cmp(TupleExpr const& e) const;
+	std::size_t computeHash() const override;
+	std::vector<Ref> getChildren() const override;
+	Ref withChildren(std::vector<Ref> const& children) const override;
+};
+
+/** Let expression (var x := value; body), binding x to value in body */
+class LetExpr : public Expr {
+	std::string var;
+	Ref value;
+	Ref body;
+public:
+	LetExpr(std::string var, Ref value, Ref body) : var(var), value(value), body(body) {}
+	std::string const& getVar() const { return var; }
+	Ref const& getValue() const { return value; }
+	Ref const& getBody() const { return body; }
+	void printBg(std::ostream& os) const override;
+	Kind kind() const override { return Kind::LET; }
+	Ref substitute(Subst const& s) const override;
+	bool contains(std::string id) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	int cmp(LetExpr const& e) const;
+	std::size_t computeHash() const override;
 };
 
 std::ostream& operator<<(std::ostream& os, Expr const& e);
-std::ostream& operator<<(std::ostream& os, Expr::Ref e);
+std::ostream& operator<<(std::ostream& os, Expr::Ref const& e);
 
 }
@@ -118,19 +118,19 @@ bool AssumeStmt::hasAttr(std::string name) const {
 	return false;
 }
 
-std::ostream& operator<<(std::ostream& os, Stmt::Ref s)
+std::ostream& operator<<(std::ostream& os, Stmt::Ref const& s)
 {
 	s->print(os);
 	return os;
 }
 
-std::ostream& operator<<(std::ostream& os, Block::ConstRef b)
+std::ostream& operator<<(std::ostream& os, Block::ConstRef const& b)
 {
 	b->print(os);
 	return os;
 }
 
-std::ostream& operator<<(std::ostream& os, Block::Ref b)
+std::ostream& operator<<(std::ostream& os, Block::Ref const& b)
 {
 	b->print(os);
 	return os;
@@ -264,4 +264,133 @@ void Block::print(std::ostream& os) const
 	print_seq(os, stmts, "	", "\n	", "");
 }
 
+//
+// Symbols
+//
+
+void AssertStmt::collectSymbols(std::set<std::string>& symbols) const
+{
+	expr->collectSymbols(symbols);
+	for (auto const& a: attrs)
+		a->collectSymbols(symbols);
+}
+
+void AssignStmt::collectSymbols(std::set<std::string>& symbols) const
+{
+	for (auto const& e: lhs)
+		e->collectSymbols(symbols);
+	for (auto const& e: rhs)
+		e->collectSymbols(symbols);
+}
+
+void AssumeStmt::collectSymbols(std::set<std::string>& symbols) const
+{
+	expr->collectSymbols(symbols);
+	for (auto const& a: attrs)
+		a->collectSymbols(symbols);
+}
+
+void CallStmt::collectSymbols(std::set<std::string>& symbols) const
+{
+	symbols.insert(proc);
+	for (auto const& a: attrs)
+		a->collectSymbols(symbols);
+	for (auto const& p: params)
+		p->collectSymbols(symbols);
+	symbols.insert(returns.begin(), returns.end());
+}
+
+void HavocStmt::collectSymbols(std::set<std::string>& symbols) const
+{
+	symbols.insert(vars.begin(), vars.end());
+}
+
+void ReturnStmt::collectSymbols(std::set<std::string>& symbols) const
+{
+	if (expr)
+		expr->collectSymbols(symbols);
+}
+
+void IfElseStmt::collectSymbols(std::set<std::string>& symbols) const
+{
+	cond->collectSymbols(symbols);
+	then->collectSymbols(symbols);
+	if (elze)
+		elze->collectSymbols(symbols);
+}
+
+void WhileStmt::collectSymbols(std::set<std::string>& symbols) const
+{
+	if (cond)
+		cond->collectSymbols(symbols);
+	body->collectSymbols(symbols);
+	for (auto const& inv: invars)
+		inv->collectSymbols(symbols);
+}
+
+void Block::collectSymbols(std::set<std::string>& symbols) const
+{
+	for (auto const& s: stmts)
+		s->collectSymbols(symbols);
+}
+
+//
+// Mapping expressions
+//
+
+Stmt::Ref AssertStmt::mapExprs(ExprMap const& f) const
+{
+	return std::make_shared<AssertStmt const>(f(expr), attrs);
+}
+
+Stmt::Ref AssignStmt::mapExprs(ExprMap const& f) const
+{
+	std::vector<Expr::Ref> rhs1;
+	for (auto const& e: rhs)
+		rhs1.push_back(f(e));
+	return std::make_shared<AssignStmt const>(lhs, rhs1);
+}
+
+Stmt::Ref AssumeStmt::mapExprs(ExprMap const& f) const
+{
+	auto result = std::make_shared<AssumeStmt>(f(expr));
+	for (auto const& a: attrs)
+		result->add(a);
+	return result;
+}
+
+Stmt::Ref CallStmt::mapExprs(ExprMap const& f) const
+{
+	std::vector<Expr::Ref> params1;
+	for (auto const& e: params)
+		params1.push_back(f(e));
+	return std::make_shared<CallStmt const>(proc, attrs, params1, returns);
+}
+
+Stmt::Ref ReturnStmt::mapExprs(ExprMap const& f) const
+{
+	return std::make_shared<ReturnStmt const>(expr ? f(expr) : nullptr);
+}
+
+Stmt::Ref IfElseStmt::mapExprs(ExprMap const& f) const
+{
+	return std::make_shared<IfElseStmt const>(
+		f(cond),
+		then->mapExprs(f),
+		elze ? elze->mapExprs(f) : nullptr);
+}
+
+Stmt::Ref WhileStmt::mapExprs(ExprMap const& f) const
+{
+	return std::make_shared<WhileStmt const>(cond ? f(cond) : nullptr, body->mapExprs(f), invars);
+}
+
+Block::ConstRef Block::mapExprs(Stmt::ExprMap const& f) const
+{
+	std::vector<Stmt::Ref> stmts1;
+	for (auto const& s: stmts)
+		stmts1.push_back(s->mapExprs(f));
+	return std::make_shared<Block const>(name, stmts1);
+}
+
 }
@@ -3,6 +3,7 @@
 //
 #pragma once
 
+#include <functional>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -21,13 +22,14 @@ using AttrConstRef = std::shared_ptr<Attr const>;
 class Specification;
 using SpecificationRef = std::shared_ptr<Specification const>;
 
-class Stmt {
+class Stmt : public std::enable_shared_from_this<Stmt> {
 public:
 	enum Kind {
 		ASSERT, ASSUME, ASSIGN, HAVOC, GOTO, CALL, RETURN, COMMENT, IFELSE, WHILE, BREAK, LABEL
 	};
 
 	using Ref = std::shared_ptr<Stmt const>;
+	using ExprMap = std::function<Expr::Ref(Expr::Ref const&)>;
 
 private:
 	Kind const kind;
@@ -64,6 +66,13 @@ public:
 	static Ref break_();
 	static Ref label(std::string name);
 	virtual void print(std::ostream& os) const = 0;
+	/** Collects the names (variables, functions, procedures, types) the statement refers to */
+	virtual void collectSymbols(std::set<std::string>&) const {}
+	/**
+	 * Creates a copy of the statement with f applied to the expressions it evaluates
+	 * (also in nested blocks). Assigned locations and loop invariants are not mapped.
+	 */
+	virtual Ref mapExprs(ExprMap const&) const { return shared_from_this(); }
 };
 
 class AssertStmt : public Stmt {
@@ -72,7 +81,10 @@ class AssertStmt : public Stmt {
 public:
 	AssertStmt(Expr::Ref e, std::vector<AttrConstRef> const& ax)
 		: Stmt(ASSERT), expr(e), attrs(ax) {}
+	Expr::Ref const& getExpr() const { return expr; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	Ref mapExprs(ExprMap const& f) const override;
 	static bool classof(Ref S) { return S->getKind() == ASSERT; }
 };
 
@@ -82,7 +94,11 @@ class AssignStmt : public Stmt {
 public:
 	AssignStmt(std::vector<Expr::Ref> const& lhs, std::vector<Expr::Ref> const& rhs)
 		: Stmt(ASSIGN), lhs(lhs), rhs(rhs) {}
+	std::vector<Expr::Ref> const& getLhs() const { return lhs; }
+	std::vector<Expr::Ref> const& getRhs() const { return rhs; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	Ref mapExprs(ExprMap const& f) const override;
 	static bool classof(Ref S) { return S->getKind() == ASSIGN; }
 };
 
@@ -91,11 +107,14 @@ class AssumeStmt : public Stmt {
 	std::vector<AttrConstRef> attrs;
 public:
 	AssumeStmt(Expr::Ref e) : Stmt(ASSUME), expr(e) {}
+	Expr::Ref const& getExpr() const { return expr; }
 	void add(AttrConstRef a) {
 		attrs.push_back(a);
 	}
 	bool hasAttr(std::string name) const;
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	Ref mapExprs(ExprMap const& f) const override;
 	static bool classof(Ref S) { return S->getKind() == ASSUME; }
 };
 
@@ -110,8 +129,13 @@ public:
 		std::vector<Expr::Ref> const& args,
 		std::vector<std::string> const& rets)
 		: Stmt(CALL), proc(p), attrs(attrs), params(args), returns(rets) {}
+	std::string const& getProc() const { return proc; }
+	std::vector<Expr::Ref> const& getParams() const { return params; }
+	std::vector<std::string> const& getReturns() const { return returns; }
 
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	Ref mapExprs(ExprMap const& f) const override;
 	static bool classof(Ref S) { return S->getKind() == CALL; }
 };
 
@@ -127,6 +151,7 @@ class GotoStmt : public Stmt {
 	std::vector<std::string> targets;
 public:
 	GotoStmt(std::vector<std::string> const& ts) : Stmt(GOTO), targets(ts) {}
+	std::vector<std::string> const& getTargets() const { return targets; }
 	void print(std::ostream& os) const override;
 	static bool classof(Ref S) { return S->getKind() == GOTO; }
 };
@@ -135,7 +160,9 @@ class HavocStmt : public Stmt {
 	std::vector<std::string> vars;
 public:
 	HavocStmt(std::vector<std::string> const& vs) : Stmt(HAVOC), vars(vs) {}
+	std::vector<std::string> const& getVars() const { return vars; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
 	static bool classof(Ref S) { return S->getKind() == HAVOC; }
 };
 
@@ -143,7 +170,10 @@ class ReturnStmt : public Stmt {
 	Expr::Ref expr;
 public:
 	ReturnStmt(Expr::Ref e = nullptr) : Stmt(RETURN), expr(e) {}
+	Expr::Ref const& getExpr() const { return expr; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	Ref mapExprs(ExprMap const& f) const override;
 	static bool classof(Ref S) { return S->getKind() == RETURN; }
 };
 
@@ -154,7 +184,12 @@ class IfElseStmt : public Stmt {
 public:
 	IfElseStmt(Expr::Ref cond, BlockConstRef then, BlockConstRef elze)
 		: Stmt(IFELSE), cond(cond), then(then), elze(elze) {}
+	Expr::Ref const& getCond() const { return cond; }
+	BlockConstRef const& getThen() const { return then; }
+	BlockConstRef const& getElse() const { return elze; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	Ref mapExprs(ExprMap const& f) const override;
 	static bool classof(Ref S) { return S->getKind() == IFELSE; }
 };
 
@@ -165,7 +200,12 @@ class WhileStmt : public Stmt {
 public:
 	WhileStmt(Expr::Ref cond, BlockConstRef body, std::vector<SpecificationRef> const& invars)
 		: Stmt(WHILE), cond(cond), body(body), invars(invars) {}
+	Expr::Ref const& getCond() const { return cond; }
+	BlockConstRef const& getBody() const { return body; }
+	std::vector<SpecificationRef> const& getInvariants() const { return invars; }
 	void print(std::ostream& os) const override;
+	void collectSymbols(std::set<std::string>& symbols) const override;
+	Ref mapExprs(ExprMap const& f) const override;
 	static bool classof(Ref S) { return S->getKind() == WHILE; }
 };
 
@@ -180,6 +220,7 @@ class LabelStmt : public Stmt {
 	std::string str;
 public:
 	LabelStmt(std::string s) : Stmt(LABEL), str(s) {}
+	std::string const& getName() const { return str; }
 	void print(std::ostream& os) const override;
 	static bool classof(Ref S) { return S->getKind() == LABEL; }
 };
@@ -200,10 +241,14 @@ public:
 
 	Block(std::string n, std::vector<Stmt::Ref> const& stmts) : name(n), stmts(stmts) {}
 	void print(std::ostream& os) const;
+	void collectSymbols(std::set<std::string>& symbols) const;
+	/** Creates a copy of the block with f applied to the expressions of the statements */
+	ConstRef mapExprs(Stmt::ExprMap const& f) const;
 	typedef StatementList::iterator iterator;
 	iterator begin() { return stmts.begin(); }
 	iterator end() { return stmts.end(); }
 	StatementList& getStatements() { return stmts; }
+	StatementList const& getStatements() const { return stmts; }
 	void addStmt(Stmt::Ref s) { stmts.push_back(s); }
 
 	void addStmts(std::vector<Stmt::Ref> const& stmts) {
@@ -211,11 +256,11 @@ public:
 			addStmt(s);
 	}
 
-	std::string getName() { return name; }
+	std::string const& getName() const { return name; }
 };
 
-std::ostream& operator<<(std::ostream& os, Stmt::Ref s);
-std::ostream& operator<<(std::ostream& os, Block::ConstRef b);
-std::ostream& operator<<(std::ostream& os, Block::Ref b);
+std::ostream& operator<<(std::ostream& os, Stmt::Ref const& s);
+std::ostream& operator<<(std::ostream& os, Block::ConstRef const& b);
+std::ostream& operator<<(std::ostream& os, Block::Ref const& b);
 
 }
@@ -316,6 +316,37 @@ list<bg::Stmt::Ref> BoogieContext::havocSumVars()
 }
 
 string BoogieContext::mapDeclName(Declaration const& decl)
+{
+	// Names are needed for each reference, so they are memoized by the ID of the
+	// declaration (names with extra scopes only until the extra scopes change)
+	auto& names = m_extraScopes.empty() ? m_declNames : m_extraScopeDeclNames;
+	auto it = names.find(decl.id());
+	if (it != names.end())
+		return it->second;
+
+	std::string name = baseDeclName(decl);
+
+	// Check if the current declaration is enclosed by any of the
+	// extra scopes, if yes, add extra ID
+	for (auto extraScope: m_extraScopes)
+	{
+		ASTNode const* running = decl.scope();
+		while (running)
+		{
+			if (running == extraScope.first)
+			{
+				name += "#" + extraScope.second;
+				break;
+			}
+			running = m_scopes[running]->enclosingNode();
+		}
+	}
+
+	names[decl.id()] = name;
+	return name;
+}
+
+string BoogieContext::baseDeclName(Declaration const& decl)
 {
 	std::string name = decl.name();
 
@@ -348,23 +379,6 @@ string BoogieContext::mapDeclName(Declaration const& decl)
 	// same for state variables and local variables in functions, (2) return
 	// variables might have no name (whereas Boogie requires a name)
 	name = name + "#" + to_string(decl.id());
-
-	// Check if the current declaration is enclosed by any of the
-	// extra scopes, if yes, add extra ID
-	for (auto extraScope: m_extraScopes)
-	{
-		ASTNode const* running = decl.scope();
-		while (running)
-		{
-			if (running == extraScope.first)
-			{
-				name += "#" + extraScope.second;
-				break;
-			}
-			running = m_scopes[running]->enclosingNode();
-		}
-	}
-
 	return name;
 }
 
@@ -1167,6 +1181,26 @@ bg::Expr::Ref BoogieContext::ecrecover(bg::Expr::Ref hash, bg::Expr::Ref v, bg::
 	return bg::Expr::fn(fnName, {hash, v, r, s});
 }
 
+BoogieContext::DocTagKey BoogieContext::docTagKey(string const& exprStr, ASTNode const* scope, bool specCases) const
+{
+	// Names of declarations depend on the extra scopes (see mapDeclName)
+	string extraScopes;
+	for (auto const& extraScope: m_extraScopes)
+		extraScopes += to_string(extraScope.first->id()) + "#" + extraScope.second + "#";
+	return DocTagKey(exprStr, specCases, scope, m_currentContract, extraScopes);
+}
+
+BoogieContext::DocTagExpr const* BoogieContext::cachedDocTagExpr(string const& exprStr, ASTNode const* scope, bool specCases) const
+{
+	auto it = m_docTagExprs.find(docTagKey(exprStr, scope, specCases));
+	return it == m_docTagExprs.end() ? nullptr : &it->second;
+}
+
+void BoogieContext::cacheDocTagExpr(string const& exprStr, ASTNode const* scope, bool specCases, DocTagExpr const& expr)
+{
+	m_docTagExprs[docTagKey(exprStr, scope, specCases)] = expr;
+}
+
 bg::Expr::Subst const& BoogieContext::getEventDataSubstitution() const
 {
 	return m_eventDataSubstitution;
@@ -1210,6 +1244,8 @@ void BoogieContext::addEventData(Expression const* expr, EventDefinition const*
 
 	// Record the data and the substitution
 	m_eventData[event].insert(dataDecl);
+	// Annotations referring to the data are converted differently from now on
+	m_docTagExprs.clear();
 }
 
 void BoogieContext::enableEventDataTrackingFor(EventDefinition const* event)
@@ -12,6 +12,8 @@
 #include <libsolidity/boogie/BoogieAstExpr.h>
 #include <libsolidity/boogie/BoogieAstStmt.h>
 #include <set>
+#include <tuple>
+#include <unordered_map>
 
 namespace dev
 {
@@ -127,6 +129,7 @@ private:
 
 	ASTBoogieStats m_stats;
 	boogie::Program m_program; // Result of the conversion is a single Boogie program (top-level node)
+	boogie::ExprInterner m_exprs; // Converted expressions, structurally equal ones are shared
 
 	std::map<std::string, boogie::Decl::Ref> m_addressLiterals;
 
@@ -166,6 +169,12 @@ private:
 	std::list<DocTagExpr> m_currentContractInvars;
 	std::map<ContractDefinition const*, std::list<SumSpec>> m_currentSumSpecs;
 
+	// Annotations already converted, keyed by the text, the kind (specification
+	// cases or expression), the scope, the contract and the extra scopes
+	typedef std::tuple<std::string, bool, ASTNode const*, ContractDefinition const*, std::string> DocTagKey;
+	std::map<DocTagKey, DocTagExpr> m_docTagExprs;
+	DocTagKey docTagKey(std::string const& exprStr, ASTNode const* scope, bool specCases) const;
+
 	typedef std::map<std::string, boogie::Decl::ConstRef> builtin_cache;
 	builtin_cache m_builtinFunctions;
 
@@ -178,6 +187,12 @@ private:
 	// A stack of extra scopes (added to declaration names) used in inlining
 	std::list<std::pair<ASTNode const*, std::string>> m_extraScopes;
 
+	// Names of declarations by ID (see mapDeclName), without and with the extra scopes
+	std::unordered_map<size_t, std::string> m_declNames;
+	std::unordered_map<size_t, std::string> m_extraScopeDeclNames;
+	/** Name of a declaration without the extra scopes. */
+	std::string baseDeclName(Declaration const& decl);
+
 	int m_nextId = 0;
 
 	bool m_warnForBalances;
@@ -203,6 +218,14 @@ public:
 	std::map<ASTNode const*, std::shared_ptr<DeclarationContainer>>& scopes() { return m_scopes; }
 	langutil::EVMVersion& evmVersion() { return m_evmVersion; }
 	std::list<DocTagExpr>& currentContractInvars() { return m_currentContractInvars; }
+	/**
+	 * Gets an annotation converted earlier in the same context, so that annotations
+	 * (e.g., of inherited or inlined functions) are parsed and type checked once.
+	 * Returns null if the annotation was not converted yet.
+	 */
+	DocTagExpr const* cachedDocTagExpr(std::string const& exprStr, ASTNode const* scope, bool specCases) const;
+	/** Stores an annotation converted without errors or warnings. */
+	void cacheDocTagExpr(std::string const& exprStr, ASTNode const* scope, bool specCases, DocTagExpr const& expr);
 	int nextId() { return m_nextId++; }
 	boogie::VarDeclRef freshTempVar(boogie::TypeDeclRef type, std::string prefix = "tmp");
 	ContractDefinition const* currentContract() const { return m_currentContract; }
@@ -211,6 +234,10 @@ public:
 
 	/** Prints the Boogie program to an output stream. */
 	void print(std::ostream& _stream) { m_program.print(_stream); }
+	/** The Boogie program produced by the conversion. */
+	boogie::Program& program() { return m_program; }
+	/** Returns the shared node that is structurally equal to the given expression. */
+	boogie::Expr::Ref intern(boogie::Expr::Ref const& expr) { return m_exprs.intern(expr); }
 
 	// Built-in functions and members
 	void includeTransferFunction();
@@ -313,9 +340,17 @@ public:
 	std::list<boogie::Stmt::Ref> havocSumVars();
 
 	/** Push an extra scope for declarations under the scode of a given node. */
-	void pushExtraScope(ASTNode const* node, std::string id) { m_extraScopes.push_back(std::make_pair(node, id)); }
+	void pushExtraScope(ASTNode const* node, std::string id)
+	{
+		m_extraScopes.push_back(std::make_pair(node, id));
+		m_extraScopeDeclNames.clear();
+	}
 	/** Pop an extra scope. */
-	void popExtraScope() { m_extraScopes.pop_back(); }
+	void popExtraScope()
+	{
+		m_extraScopes.pop_back();
+		m_extraScopeDeclNames.clear();
+	}
 
 	// Error reporting
 	void reportError(ASTNode const* associatedNode, std::string message);
@@ -0,0 +1,87 @@
+//
+// This file is distributed under the MIT License. See SMACK-LICENSE for details.
+//
+#include <libsolidity/boogie/BoogieLetBinder.h>
+#include <libsolidity/boogie/BoogieAstDecl.h>
+#include <libsolidity/boogie/BoogieAstStmt.h>
+#include <functional>
+#include <unordered_map>
+
+namespace boogie
+{
+
+void LetBinder::bind(Program& program)
+{
+	auto bindExpr = [this](Expr::Ref const& expr) { return bind(expr); };
+	for (auto const& decl: program.getDeclarations())
+	{
+		auto proc = std::dynamic_pointer_cast<ProcDecl>(decl);
+		if (!proc)
+			continue;
+		for (auto const& block: proc->getBlocks())
+			for (auto& stmt: block->getStatements())
+				stmt = stmt->mapExprs(bindExpr);
+	}
+}
+
+Expr::Ref LetBinder::bind(Expr::Ref const& expr)
+{
+	using ExprMap = std::unordered_map<Expr::Ref, Expr::Ref, Expr::RefHash, Expr::RefEqual>;
+
+	// Count the occurrences of subexpressions, repeated ones are not traversed
+	// again (their children are bound as part of them). Subexpressions are
+	// collected in post-order, so children come before their parents.
+	std::unordered_map<Expr::Ref, unsigned, Expr::RefHash, Expr::RefEqual> occurrences;
+	std::vector<Expr::Ref> subexprs;
+	std::function<void(Expr::Ref const&)> count = [&](Expr::Ref const& e)
+	{
+		if (occurrences[e]++ > 0)
+			return;
+		for (auto const& child: e->getChildren())
+			count(child);
+		subexprs.push_back(e);
+	};
+	count(expr);
+
+	ExprMap bound; // Bound subexpressions to their variables
+	std::function<Expr::Ref(Expr::Ref const&)> replace;
+	// Replaces bound subexpressions in the children of an expression
+	auto replaceChildren = [&](Expr::Ref const& e)
+	{
+		auto children = e->getChildren();
+		bool changed = false;
+		for (auto& child: children)
+		{
+			auto child1 = replace(child);
+			changed = changed || child1 != child;
+			child = child1;
+		}
+		return changed ? e->withChildren(children) : e;
+	};
+	replace = [&](Expr::Ref const& e)
+	{
+		auto it = bound.find(e);
+		return it != bound.end() ? it->second : replaceChildren(e);
+	};
+
+	// Bind repeated subexpressions (that are not just variables or literals)
+	std::vector<std::pair<std::string, Expr::Ref>> bindings;
+	for (auto const& e: subexprs)
+	{
+		if (occurrences[e] < 2 || e->getChildren().empty() || e->kind() == Expr::Kind::TUPLE)
+			continue;
+		std::string var = "__cse#" + std::to_string(++m_counter);
+		// Children are bound before, so the value can refer to their variables
+		bindings.push_back({var, replaceChildren(e)});
+		bound[e] = Expr::id(var);
+	}
+	if (bindings.empty())
+		return expr;
+
+	Expr::Ref result = replace(expr);
+	for (auto it = bindings.rbegin(); it != bindings.rend(); ++it)
+		result = Expr::let(it->first, it->second, result);
+	return result;
+}
+
+}
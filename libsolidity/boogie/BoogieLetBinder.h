@@ -0,0 +1,34 @@
+//
+// This file is distributed under the MIT License. See SMACK-LICENSE for details.
+//
+#pragma once
+
+#include <libsolidity/boogie/BoogieAst.h>
+#include <libsolidity/boogie/BoogieAstExpr.h>
+
+namespace boogie
+{
+
+/**
+ * Binds subexpressions occurring multiple times in an expression to variables
+ * using let expressions, e.g., x[this] + x[this] becomes
+ * (var __cse#1 := x[this]; __cse#1 + __cse#1). The subexpressions are evaluated
+ * in the same state, so the meaning does not change, but repeated parts (and the
+ * verification conditions generated from them) only appear once. Subexpressions
+ * referring to bound variables (quantifiers) or evaluated in a different state
+ * (old) are not bound.
+ */
+class LetBinder
+{
+public:
+	/** Binds repeated subexpressions in the statements of all procedure implementations */
+	void bind(Program& program);
+
+	/** Binds repeated subexpressions of a single expression */
+	Expr::Ref bind(Expr::Ref const& expr);
+
+private:
+	unsigned m_counter = 0; // For fresh variable names
+};
+
+}
@@ -0,0 +1,230 @@
+//
+// This file is distributed under the MIT License. See SMACK-LICENSE for details.
+//
+#include <libsolidity/boogie/BoogieSlicer.h>
+#include <libsolidity/boogie/BoogieAstStmt.h>
+#include <liblangutil/Exceptions.h>
+
+namespace boogie
+{
+
+namespace
+{
+
+/** Collects the globals assigned in a block and the procedures called */
+void collectModifies(Block const& block, std::set<std::string> const& globals,
+		std::set<std::string>& mods, std::set<std::string>& callees)
+{
+	auto addIfGlobal = [&](std::string const& name)
+	{
+		if (globals.count(name))
+			mods.insert(name);
+	};
+	for (auto const& stmt: block.getStatements())
+	{
+		switch (stmt->getKind())
+		{
+		case Stmt::ASSIGN:
+			for (Expr::Ref lhs: std::dynamic_pointer_cast<AssignStmt const>(stmt)->getLhs())
+			{
+				while (auto sel = std::dynamic_pointer_cast<SelExpr const>(lhs))
+					lhs = sel->getBase();
+				if (auto var = std::dynamic_pointer_cast<VarExpr const>(lhs))
+					addIfGlobal(var->getName());
+			}
+			break;
+		case Stmt::HAVOC:
+			for (auto const& var: std::dynamic_pointer_cast<HavocStmt const>(stmt)->getVars())
+				addIfGlobal(var);
+			break;
+		case Stmt::CALL:
+		{
+			auto call = std::dynamic_pointer_cast<CallStmt const>(stmt);
+			for (auto const& ret: call->getReturns())
+				addIfGlobal(ret);
+			callees.insert(call->getProc());
+			break;
+		}
+		case Stmt::IFELSE:
+		{
+			auto ifElse = std::dynamic_pointer_cast<IfElseStmt const>(stmt);
+			collectModifies(*ifElse->getThen(), globals, mods, callees);
+			if (ifElse->getElse())
+				collectModifies(*ifElse->getElse(), globals, mods, callees);
+			break;
+		}
+		case Stmt::WHILE:
+			collectModifies(*std::dynamic_pointer_cast<WhileStmt const>(stmt)->getBody(), globals, mods, callees);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+}
+
+ProgramSlicer::ProgramSlicer(Program& program)
+{
+	for (auto const& decl: program.getDeclarations())
+	{
+		// Comments are not needed in slices
+		if (decl->getKind() == Decl::COMMENT)
+			continue;
+
+		size_t index = m_decls.size();
+		m_decls.push_back(DeclInfo{decl, {}, {}});
+		DeclInfo& info = m_decls.back();
+		decl->collectSymbols(info.symbols);
+
+		switch (decl->getKind())
+		{
+		case Decl::AXIOM:
+			m_axioms.push_back(index);
+			break;
+		case Decl::CODE:
+			m_unknown.push_back(index);
+			break;
+		case Decl::PROCEDURE:
+			std::dynamic_pointer_cast<ProcDecl>(decl)->collectDeclarationSymbols(info.declSymbols);
+			m_declsByName[decl->getName()].push_back(index);
+			break;
+		case Decl::FUNCTION:
+			m_declsByName[decl->getName()].push_back(index);
+			// Datatypes need their constructors, so the constructor is also reached via the type
+			if (decl->hasAttr("constructor"))
+				m_declsByName[std::dynamic_pointer_cast<FuncDecl>(decl)->getType()->getName()].push_back(index);
+			break;
+		default:
+			m_declsByName[decl->getName()].push_back(index);
+			break;
+		}
+	}
+	inferModifies();
+}
+
+void ProgramSlicer::inferModifies()
+{
+	std::set<std::string> globals;
+	for (auto const& info: m_decls)
+		if (info.decl->getKind() == Decl::VARIABLE)
+			globals.insert(info.decl->getName());
+
+	std::map<std::string, std::set<std::string>> callees;
+	for (auto const& info: m_decls)
+	{
+		auto proc = std::dynamic_pointer_cast<ProcDecl>(info.decl);
+		if (!proc)
+			continue;
+		auto& mods = m_modifies[proc->getName()];
+		mods.insert(proc->getModifies().begin(), proc->getModifies().end());
+		for (auto const& block: proc->getBlocks())
+			collectModifies(*block, globals, mods, callees[proc->getName()]);
+	}
+
+	// Propagate the modifies of the callees until a fixed point is reached
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto& mods: m_modifies)
+			for (auto const& callee: callees[mods.first])
+			{
+				auto it = m_modifies.find(callee);
+				if (it == m_modifies.end() || callee == mods.first)
+					continue;
+				for (auto const& mod: it->second)
+					changed = mods.second.insert(mod).second || changed;
+			}
+	}
+
+	// The declarations of procedures refer to their inferred modifies
+	for (auto& info: m_decls)
+		if (info.decl->getKind() == Decl::PROCEDURE)
+		{
+			auto const& mods = m_modifies[info.decl->getName()];
+			info.declSymbols.insert(mods.begin(), mods.end());
+		}
+}
+
+Program ProgramSlicer::slice(ProcDeclRef const& proc) const
+{
+	std::vector<Inclusion> included(m_decls.size(), Inclusion::NONE);
+	std::set<std::string> reached;
+	std::vector<std::string> worklist;
+
+	auto include = [&](size_t index, Inclusion inclusion)
+	{
+		if (included[index] >= inclusion)
+			return;
+		included[index] = inclusion;
+		auto const& symbols = inclusion == Inclusion::FULL ? m_decls[index].symbols : m_decls[index].declSymbols;
+		worklist.insert(worklist.end(), symbols.begin(), symbols.end());
+	};
+
+	bool found = false;
+	for (size_t i = 0; i < m_decls.size(); ++i)
+		if (m_decls[i].decl == proc)
+		{
+			include(i, Inclusion::FULL);
+			reached.insert(proc->getName());
+			found = true;
+		}
+	solAssert(found, "Procedure to slice is not part of the program");
+	for (size_t i: m_unknown)
+		include(i, Inclusion::FULL);
+
+	bool changed = true;
+	while (changed)
+	{
+		// Process the declarations reachable via names
+		while (!worklist.empty())
+		{
+			std::string name = worklist.back();
+			worklist.pop_back();
+			if (!reached.insert(name).second)
+				continue;
+			auto it = m_declsByName.find(name);
+			if (it == m_declsByName.end())
+				continue;
+			for (size_t i: it->second)
+			{
+				Decl const& decl = *m_decls[i].decl;
+				bool declarationOnly = decl.getKind() == Decl::PROCEDURE && !decl.hasAttr("inline");
+				include(i, declarationOnly ? Inclusion::DECLARATION : Inclusion::FULL);
+			}
+		}
+
+		// Include axioms that constrain any of the reached symbols
+		changed = false;
+		for (size_t i: m_axioms)
+		{
+			if (included[i] != Inclusion::NONE)
+				continue;
+			for (auto const& symbol: m_decls[i].symbols)
+				if (reached.count(symbol))
+				{
+					include(i, Inclusion::FULL);
+					changed = true;
+					break;
+				}
+		}
+	}
+
+	Program result;
+	for (size_t i = 0; i < m_decls.size(); ++i)
+	{
+		if (included[i] == Inclusion::FULL)
+			result.getDeclarations().push_back(m_decls[i].decl);
+		else if (included[i] == Inclusion::DECLARATION)
+		{
+			ProcDeclRef decl = std::dynamic_pointer_cast<ProcDecl>(m_decls[i].decl)->withoutBody();
+			auto const& mods = m_modifies.at(decl->getName());
+			decl->getModifies().assign(mods.begin(), mods.end());
+			result.getDeclarations().push_back(decl);
+		}
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,56 @@
+//
+// This file is distributed under the MIT License. See SMACK-LICENSE for details.
+//
+#pragma once
+
+#include <libsolidity/boogie/BoogieAst.h>
+#include <libsolidity/boogie/BoogieAstDecl.h>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace boogie
+{
+
+/**
+ * Computes the declarations (types, functions, axioms, globals and other
+ * procedures) that a procedure transitively depends on, and creates the
+ * minimal program needed to verify it. Called procedures are only declared
+ * as calls are checked modularly, except for inlined procedures whose
+ * implementation is also needed. Axioms are included if they refer to any
+ * of the included declarations.
+ */
+class ProgramSlicer
+{
+public:
+	explicit ProgramSlicer(Program& program);
+
+	/** Creates the slice of the program needed to verify the given procedure */
+	Program slice(ProcDeclRef const& proc) const;
+
+private:
+	/**
+	 * Computes the globals modified by each procedure (including its callees).
+	 * Boogie infers these from the implementation (/doModSetAnalysis), which is
+	 * not available for procedures that are only declared in a slice.
+	 */
+	void inferModifies();
+
+	enum class Inclusion { NONE, DECLARATION, FULL };
+
+	struct DeclInfo
+	{
+		DeclRef decl;
+		std::set<std::string> symbols; // Names the (full) declaration refers to
+		std::set<std::string> declSymbols; // Names the declaration refers to without implementation
+	};
+
+	std::vector<DeclInfo> m_decls; // Declarations in program order
+	std::map<std::string, std::vector<size_t>> m_declsByName; // Declarations reached via a name
+	std::vector<size_t> m_axioms; // Axioms (unnamed, reached via their symbols)
+	std::vector<size_t> m_unknown; // Declarations with unknown dependencies (kept in all slices)
+	std::map<std::string, std::set<std::string>> m_modifies; // Inferred modifies clauses of procedures
+};
+
+}
@@ -0,0 +1,826 @@
+//
+// This file is distributed under the MIT License. See SMACK-LICENSE for details.
+//
+#include <libsolidity/boogie/BoogieSmtChecker.h>
+#include <libsolidity/boogie/BoogieAstStmt.h>
+#include <libsolidity/formal/SolverInterface.h>
+#ifdef HAVE_Z3
+#include <libsolidity/formal/Z3Interface.h>
+#endif
+#ifdef HAVE_CVC4
+#include <libsolidity/formal/CVC4Interface.h>
+#endif
+#include <boost/algorithm/string/predicate.hpp>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <set>
+
+namespace smt = dev::solidity::smt;
+
+namespace boogie
+{
+
+namespace
+{
+
+using smt::Expression;
+using smt::SortPointer;
+
+/** Thrown when the program is outside the supported fragment */
+struct Unsupported
+{
+	std::string reason;
+};
+
+/** Thrown when the solver cannot give an answer */
+struct GiveUp
+{
+	SmtChecker::Outcome outcome;
+};
+
+std::unique_ptr<smt::SolverInterface> makeSolver(std::string const& solver)
+{
+#ifdef HAVE_Z3
+	if (solver == "z3")
+		return std::make_unique<smt::Z3Interface>();
+#endif
+#ifdef HAVE_CVC4
+	if (solver == "cvc4")
+		return std::make_unique<smt::CVC4Interface>();
+#endif
+	(void)solver;
+	return nullptr;
+}
+
+std::string const& bindingName(Binding const& binding)
+{
+	auto var = std::dynamic_pointer_cast<VarExpr const>(binding.id);
+	if (!var)
+		throw Unsupported{"unnamed parameter"};
+	return var->getName();
+}
+
+/**
+ * Symbolic execution of a single procedure, see SmtChecker. Variables are
+ * mapped to solver expressions that are always leaves (solver variables or
+ * literals), so states can be compared and merged by name.
+ */
+class Encoder
+{
+public:
+	Encoder(smt::SolverInterface& solver, unsigned timeout)
+		: m_solver(solver), m_timeout(timeout), m_start(std::chrono::steady_clock::now()) {}
+
+	SmtChecker::Result check(Program& program, ProcDeclRef const& proc);
+
+private:
+	using State = std::map<std::string, Expression>;
+
+	/** Environment for evaluating expressions */
+	struct Env
+	{
+		State const* vars;
+		State const* old; // State referred to by old(), null if not allowed
+		State bound; // Parameters of functions and specifications, let variables
+	};
+
+	/** A path reaching a program point */
+	struct Path
+	{
+		Expression pc;
+		State vars;
+	};
+
+	void declare(Program& program);
+	SortPointer sort(TypeDeclRef const& type);
+	SortPointer parseSort(std::string const& smt, size_t& pos);
+
+	Expression fresh(std::string const& name, SortPointer const& sort);
+	Expression fresh(std::string const& name);
+	/** Introduces a variable for a compound value so that states only contain leaves */
+	Expression define(std::string const& name, Expression const& value);
+
+	Expression eval(Expr::Ref const& expr, Env const& env);
+	Expression eval(Expr::Ref const& expr) { return eval(expr, Env{&m_vars, &m_old, {}}); }
+	Expression evalBinary(BinExpr const& expr, Env const& env);
+
+	void assume(Expression const& expr);
+	void prove(Expression const& expr, SmtChecker::Failure const& failure);
+
+	void execBlock(Block const& block);
+	void exec(Stmt::Ref const& stmt, Stmt::Ref const& previous);
+	void assign(AssignStmt const& stmt);
+	void call(Stmt::Ref const& stmt, Stmt::Ref const& previous);
+	void ifElse(IfElseStmt const& stmt);
+	void loop(Stmt::Ref const& stmt);
+	void jump(std::string const& label);
+	void label(std::string const& label);
+	void checkPostconditions(Stmt::Ref const& stmt);
+
+	void merge(std::vector<Path> const& paths);
+	Path current() const { return Path{m_pc, m_vars}; }
+	void collectModified(Block const& block, std::set<std::string>& vars) const;
+
+	smt::SolverInterface& m_solver;
+	unsigned m_timeout;
+	std::chrono::steady_clock::time_point m_start;
+	SmtChecker::Result m_result;
+	unsigned m_nextId = 0;
+
+	std::map<std::string, SortPointer> m_sortsByType; // SMT type to sort
+	std::map<std::string, SortPointer> m_sorts; // Sorts of variables and constants
+	std::map<std::string, Expression> m_functions; // Uninterpreted functions
+	std::map<std::string, FuncDeclRef> m_definitions; // Functions with a body (inlined)
+	std::map<std::string, ProcDeclRef> m_procs;
+	ProcDeclRef m_proc;
+
+	Expression m_pc = Expression(true);
+	bool m_reachable = true;
+	State m_vars;
+	State m_old;
+	std::map<std::string, std::vector<Path>> m_jumps; // Pending jumps to labels
+	std::set<std::string> m_labels; // Labels already passed
+};
+
+SmtChecker::Result Encoder::check(Program& program, ProcDeclRef const& proc)
+{
+	try
+	{
+		m_proc = proc;
+		declare(program);
+
+		// Parameters, returns and locals are variables of the procedure like the globals
+		std::vector<std::pair<std::string, TypeDeclRef>> vars;
+		for (auto& param: proc->getParameters())
+			vars.emplace_back(bindingName(param), param.type);
+		for (auto& ret: proc->getReturns())
+			vars.emplace_back(bindingName(ret), ret.type);
+		for (auto const& decl: proc->getDeclarations())
+		{
+			auto var = std::dynamic_pointer_cast<VarDecl>(decl);
+			if (!var)
+				throw Unsupported{"local declaration " + decl->getName()};
+			vars.emplace_back(var->getName(), var->getType());
+		}
+		for (auto const& var: vars)
+		{
+			m_sorts[var.first] = sort(var.second);
+			m_vars.insert_or_assign(var.first, fresh(var.first));
+		}
+		m_old = m_vars;
+
+		for (auto const& req: proc->getRequires())
+			assume(eval(req->getExpr()));
+		for (auto const& block: proc->getBlocks())
+		{
+			if (!block->getName().empty())
+				label(block->getName());
+			execBlock(*block);
+		}
+		if (!m_jumps.empty())
+			throw Unsupported{"jump to unknown label " + m_jumps.begin()->first};
+		checkPostconditions(nullptr);
+
+		m_result.outcome = m_result.failures.empty() ? SmtChecker::Outcome::Verified : SmtChecker::Outcome::Errors;
+	}
+	catch (Unsupported const& unsupported)
+	{
+		m_result.outcome = SmtChecker::Outcome::Unsupported;
+		m_result.reason = unsupported.reason;
+		m_result.failures.clear();
+	}
+	catch (GiveUp const& giveUp)
+	{
+		m_result.outcome = giveUp.outcome;
+		m_result.failures.clear();
+	}
+	return m_result;
+}
+
+void Encoder::declare(Program& program)
+{
+	std::map<std::string, std::vector<Expression>> uniqueConsts; // Grouped by SMT type
+	std::vector<Expr::Ref> axioms;
+	for (auto const& decl: program.getDeclarations())
+	{
+		switch (decl->getKind())
+		{
+		case Decl::CONSTANT:
+		{
+			auto c = std::dynamic_pointer_cast<ConstDecl>(decl);
+			m_sorts.emplace(c->getName(), sort(c->getType()));
+			Expression value = fresh(c->getName());
+			m_vars.insert_or_assign(c->getName(), value);
+			if (c->isUnique())
+				uniqueConsts[c->getType()->getSmtType()].push_back(value);
+			break;
+		}
+		case Decl::VARIABLE:
+		{
+			auto var = std::dynamic_pointer_cast<VarDecl>(decl);
+			m_sorts.emplace(var->getName(), sort(var->getType()));
+			m_vars.insert_or_assign(var->getName(), fresh(var->getName()));
+			break;
+		}
+		case Decl::FUNCTION:
+		{
+			auto func = std::dynamic_pointer_cast<FuncDecl>(decl);
+			for (auto const& attr: func->getAttrs())
+				if (attr->getName() != "inline")
+					throw Unsupported{"function " + func->getName() + " with attribute " + attr->getName()};
+			if (func->getBody())
+				m_definitions[func->getName()] = func;
+			else
+			{
+				std::vector<SortPointer> domain;
+				for (auto const& param: func->getParams())
+					domain.push_back(sort(param.type));
+				auto funcSort = std::make_shared<smt::FunctionSort>(domain, sort(func->getType()));
+				m_functions.insert_or_assign(func->getName(), m_solver.newVariable(func->getName(), funcSort));
+			}
+			break;
+		}
+		case Decl::TYPE:
+			if (std::dynamic_pointer_cast<DataTypeDecl>(decl))
+				throw Unsupported{"datatype " + decl->getName()};
+			break;
+		case Decl::AXIOM:
+			axioms.push_back(std::dynamic_pointer_cast<AxiomDecl>(decl)->getExpr());
+			break;
+		case Decl::PROCEDURE:
+			m_procs[decl->getName()] = std::dynamic_pointer_cast<ProcDecl>(decl);
+			break;
+		case Decl::CODE:
+			throw Unsupported{"code declaration " + decl->getName()};
+		case Decl::COMMENT:
+			break;
+		}
+	}
+
+	for (auto const& consts: uniqueConsts)
+		for (size_t i = 0; i < consts.second.size(); ++i)
+			for (size_t j = i + 1; j < consts.second.size(); ++j)
+				m_solver.addAssertion(consts.second[i] != consts.second[j]);
+	for (auto const& axiom: axioms)
+		m_solver.addAssertion(eval(axiom, Env{&m_vars, nullptr, {}}));
+}
+
+SortPointer Encoder::sort(TypeDeclRef const& type)
+{
+	std::string const& smt = type->getSmtType();
+	auto it = m_sortsByType.find(smt);
+	if (it != m_sortsByType.end())
+		return it->second;
+	size_t pos = 0;
+	SortPointer result = parseSort(smt, pos);
+	if (pos != smt.size())
+		throw Unsupported{"type " + smt};
+	m_sortsByType[smt] = result;
+	return result;
+}
+
+SortPointer Encoder::parseSort(std::string const& smt, size_t& pos)
+{
+	auto skipSpaces = [&]() { while (pos < smt.size() && smt[pos] == ' ') ++pos; };
+	auto token = [&]()
+	{
+		skipSpaces();
+		size_t begin = pos;
+		while (pos < smt.size() && smt[pos] != ' ' && smt[pos] != '(' && smt[pos] != ')')
+			++pos;
+		return smt.substr(begin, pos - begin);
+	};
+
+	skipSpaces();
+	if (pos < smt.size() && smt[pos] == '(')
+	{
+		++pos;
+		if (token() != "Array")
+			throw Unsupported{"type " + smt};
+		SortPointer domain = parseSort(smt, pos);
+		SortPointer range = parseSort(smt, pos);
+		skipSpaces();
+		if (pos >= smt.size() || smt[pos] != ')')
+			throw Unsupported{"type " + smt};
+		++pos;
+		return std::make_shared<smt::ArraySort>(domain, range);
+	}
+	std::string name = token();
+	if (name == "Int")
+		return std::make_shared<smt::Sort>(smt::Kind::Int);
+	if (name == "Bool")
+		return std::make_shared<smt::Sort>(smt::Kind::Bool);
+	// Values of uninterpreted types are only compared for equality, so any
+	// infinite domain (integers) gives the same result for quantifier-free formulas
+	if (boost::starts_with(name, "T@"))
+		return std::make_shared<smt::Sort>(smt::Kind::Int);
+	throw Unsupported{"type " + smt};
+}
+
+Expression Encoder::fresh(std::string const& name, SortPointer const& sort)
+{
+	return m_solver.newVariable(name + "@" + std::to_string(m_nextId++), sort);
+}
+
+Expression Encoder::fresh(std::string const& name)
+{
+	auto it = m_sorts.find(name);
+	if (it == m_sorts.end())
+		throw Unsupported{"identifier " + name};
+	return fresh(name, it->second);
+}
+
+Expression Encoder::define(std::string const& name, Expression const& value)
+{
+	if (value.arguments().empty())
+		return value;
+	Expression var = fresh(name, value.sort());
+	m_solver.addAssertion(var == value);
+	return var;
+}
+
+Expression Encoder::eval(Expr::Ref const& expr, Env const& env)
+{
+	switch (expr->kind())
+	{
+	case Expr::Kind::LIT_BOOL:
+		return Expression(dynamic_cast<BoolLit const&>(*expr).getVal());
+	case Expr::Kind::LIT_INT:
+		return Expression(dynamic_cast<IntLit const&>(*expr).getVal());
+	case Expr::Kind::VARIABLE:
+	{
+		std::string const& name = dynamic_cast<VarExpr const&>(*expr).getName();
+		auto it = env.bound.find(name);
+		if (it != env.bound.end())
+			return it->second;
+		it = env.vars->find(name);
+		if (it != env.vars->end())
+			return it->second;
+		throw Unsupported{"identifier " + name};
+	}
+	case Expr::Kind::OLD:
+	{
+		if (!env.old)
+			throw Unsupported{"old expression outside of a procedure"};
+		Env oldEnv{env.old, env.old, env.bound};
+		return eval(dynamic_cast<OldExpr const&>(*expr).getExpr(), oldEnv);
+	}
+	case Expr::Kind::LET:
+	{
+		auto const& let = dynamic_cast<LetExpr const&>(*expr);
+		Env letEnv = env;
+		letEnv.bound.insert_or_assign(let.getVar(), eval(let.getValue(), env));
+		return eval(let.getBody(), letEnv);
+	}
+	case Expr::Kind::COND:
+	{
+		auto const& cond = dynamic_cast<CondExpr const&>(*expr);
+		return Expression::ite(eval(cond.getCond(), env), eval(cond.getThen(), env), eval(cond.getElse(), env));
+	}
+	case Expr::Kind::NOT:
+		return !eval(dynamic_cast<NotExpr const&>(*expr).getExpr(), env);
+	case Expr::Kind::NEG:
+		return Expression(bigint(0)) - eval(dynamic_cast<NegExpr const&>(*expr).getExpr(), env);
+	case Expr::Kind::FN:
+	{
+		auto const& fn = dynamic_cast<FunExpr const&>(*expr);
+		std::vector<Expression> args;
+		for (auto const& arg: fn.getArgs())
+			args.push_back(eval(arg, env));
+		auto def = m_definitions.find(fn.getName());
+		if (def != m_definitions.end())
+		{
+			auto const& params = def->second->getParams();
+			if (params.size() != args.size())
+				throw Unsupported{"call to " + fn.getName()};
+			Env funcEnv{env.vars, nullptr, {}};
+			for (size_t i = 0; i < params.size(); ++i)
+				funcEnv.bound.insert_or_assign(bindingName(params[i]), args[i]);
+			return eval(def->second->getBody(), funcEnv);
+		}
+		auto func = m_functions.find(fn.getName());
+		if (func == m_functions.end())
+			throw Unsupported{"function " + fn.getName()};
+		return func->second(std::move(args));
+	}
+	case Expr::Kind::ARRAY_SELECT:
+	{
+		auto const& sel = dynamic_cast<ArrSelExpr const&>(*expr);
+		return Expression::select(eval(sel.getBase(), env), eval(sel.getIdx(), env));
+	}
+	case Expr::Kind::ARRAY_UPDATE:
+	{
+		auto const& upd = dynamic_cast<ArrUpdExpr const&>(*expr);
+		return Expression::store(eval(upd.getBase(), env), eval(upd.getIdx(), env), eval(upd.getVal(), env));
+	}
+	case Expr::Kind::ARRAY_CONST:
+	{
+		auto const& arr = dynamic_cast<ArrConstExpr const&>(*expr);
+		return Expression::const_array(Expression(sort(arr.getType())), eval(arr.getVal(), env));
+	}
+	case Expr::Kind::EXISTS:
+	case Expr::Kind::FORALL:
+		throw Unsupported{"quantifier"};
+	case Expr::Kind::LIT_BV:
+	case Expr::Kind::LIT_STRING:
+	case Expr::Kind::DATATYPE_SELECT:
+	case Expr::Kind::DATATYPE_UPDATE:
+	case Expr::Kind::TUPLE:
+	case Expr::Kind::ERROR:
+		throw Unsupported{"expression " + expr->toBgString()};
+	default:
+		if (auto bin = dynamic_cast<BinExpr const*>(expr.get()))
+			return evalBinary(*bin, env);
+		throw Unsupported{"expression " + expr->toBgString()};
+	}
+}
+
+Expression Encoder::evalBinary(BinExpr const& expr, Env const& env)
+{
+	Expression lhs = eval(expr.getLhs(), env);
+	Expression rhs = eval(expr.getRhs(), env);
+	switch (expr.getOp())
+	{
+	case BinExpr::Iff: return lhs == rhs;
+	case BinExpr::Imp: return Expression::implies(lhs, rhs);
+	case BinExpr::Or: return lhs || rhs;
+	case BinExpr::And: return lhs && rhs;
+	case BinExpr::Eq: return lhs == rhs;
+	case BinExpr::Neq: return lhs != rhs;
+	case BinExpr::Lt: return lhs < rhs;
+	case BinExpr::Gt: return lhs > rhs;
+	case BinExpr::Lte: return lhs <= rhs;
+	case BinExpr::Gte: return lhs >= rhs;
+	case BinExpr::Plus: return lhs + rhs;
+	case BinExpr::Minus: return lhs - rhs;
+	case BinExpr::Times: return lhs * rhs;
+	case BinExpr::IntDiv: return lhs / rhs;
+	case BinExpr::Mod: return lhs % rhs;
+	default:
+		// Real division, exponentiation and bitvector operations
+		throw Unsupported{"expression " + expr.toBgString()};
+	}
+}
+
+void Encoder::assume(Expression const& expr)
+{
+	m_pc = define("$pc", m_pc && expr);
+}
+
+void Encoder::prove(Expression const& expr, SmtChecker::Failure const& failure)
+{
+	// The query may only use the rest of the time of the procedure
+	using namespace std::chrono;
+	milliseconds remaining(0);
+	if (m_timeout > 0)
+	{
+		remaining = seconds(m_timeout) - duration_cast<milliseconds>(steady_clock::now() - m_start);
+		if (remaining <= milliseconds(0))
+			throw GiveUp{SmtChecker::Outcome::Timeout};
+		m_solver.setTimeout(unsigned(remaining.count()));
+	}
+
+	m_result.obligations++;
+	m_solver.push();
+	m_solver.addAssertion(m_pc && !expr);
+	smt::CheckResult result = m_solver.check({}).first;
+	m_solver.pop();
+	switch (result)
+	{
+	case smt::CheckResult::SATISFIABLE:
+		m_result.failures.push_back(failure);
+		break;
+	case smt::CheckResult::UNSATISFIABLE:
+		break;
+	default:
+		if (m_timeout > 0 && steady_clock::now() - m_start >= seconds(m_timeout))
+			throw GiveUp{SmtChecker::Outcome::Timeout};
+		throw GiveUp{SmtChecker::Outcome::Unknown};
+	}
+	// Like in Boogie, the assertion is assumed afterwards so that each failure is reported once
+	assume(expr);
+}
+
+void Encoder::execBlock(Block const& block)
+{
+	Stmt::Ref previous;
+	for (auto const& stmt: block.getStatements())
+	{
+		exec(stmt, previous);
+		if (stmt->getKind() != Stmt::COMMENT)
+			previous = stmt;
+	}
+}
+
+void Encoder::exec(Stmt::Ref const& stmt, Stmt::Ref const& previous)
+{
+	// Unreachable statements are skipped, only labels can make the code reachable again
+	if (!m_reachable && stmt->getKind() != Stmt::LABEL)
+		return;
+
+	switch (stmt->getKind())
+	{
+	case Stmt::ASSERT:
+		prove(eval(std::dynamic_pointer_cast<AssertStmt const>(stmt)->getExpr()),
+				SmtChecker::Failure{SmtChecker::Failure::Assertion, stmt, nullptr, nullptr});
+		break;
+	case Stmt::ASSUME:
+		assume(eval(std::dynamic_pointer_cast<AssumeStmt const>(stmt)->getExpr()));
+		break;
+	case Stmt::ASSIGN:
+		assign(dynamic_cast<AssignStmt const&>(*stmt));
+		break;
+	case Stmt::HAVOC:
+		for (auto const& var: std::dynamic_pointer_cast<HavocStmt const>(stmt)->getVars())
+			m_vars.insert_or_assign(var, fresh(var));
+		break;
+	case Stmt::CALL:
+		call(stmt, previous);
+		break;
+	case Stmt::RETURN:
+		if (std::dynamic_pointer_cast<ReturnStmt const>(stmt)->getExpr())
+			throw Unsupported{"return with value"};
+		checkPostconditions(stmt);
+		m_reachable = false;
+		break;
+	case Stmt::GOTO:
+	{
+		auto const& targets = std::dynamic_pointer_cast<GotoStmt const>(stmt)->getTargets();
+		if (targets.size() != 1)
+			throw Unsupported{"nondeterministic jump"};
+		jump(targets[0]);
+		break;
+	}
+	case Stmt::LABEL:
+		label(std::dynamic_pointer_cast<LabelStmt const>(stmt)->getName());
+		break;
+	case Stmt::IFELSE:
+		ifElse(dynamic_cast<IfElseStmt const&>(*stmt));
+		break;
+	case Stmt::WHILE:
+		loop(stmt);
+		break;
+	case Stmt::BREAK:
+		throw Unsupported{"break"};
+	case Stmt::COMMENT:
+		break;
+	}
+}
+
+void Encoder::assign(AssignStmt const& stmt)
+{
+	auto const& lhss = stmt.getLhs();
+	auto const& rhss = stmt.getRhs();
+	if (lhss.size() != rhss.size())
+		throw Unsupported{"assignment"};
+
+	// All sides are evaluated in the state before the assignment
+	std::vector<std::pair<std::string, Expression>> updates;
+	for (size_t i = 0; i < lhss.size(); ++i)
+	{
+		Expr::Ref lhs = lhss[i];
+		Expression value = eval(rhss[i]);
+		// Assignments to elements (a[i][j] := v) update the whole array (a := a[i := a[i][j := v]])
+		while (auto sel = std::dynamic_pointer_cast<ArrSelExpr const>(lhs))
+		{
+			value = Expression::store(eval(sel->getBase()), eval(sel->getIdx()), value);
+			lhs = sel->getBase();
+		}
+		auto var = std::dynamic_pointer_cast<VarExpr const>(lhs);
+		if (!var || !m_sorts.count(var->getName()))
+			throw Unsupported{"assignment to " + lhs->toBgString()};
+		updates.emplace_back(var->getName(), value);
+	}
+	for (auto const& update: updates)
+		m_vars.insert_or_assign(update.first, define(update.first, update.second));
+}
+
+void Encoder::call(Stmt::Ref const& stmt, Stmt::Ref const& previous)
+{
+	auto const& callStmt = dynamic_cast<CallStmt const&>(*stmt);
+	auto it = m_procs.find(callStmt.getProc());
+	if (it == m_procs.end())
+		throw Unsupported{"call to " + callStmt.getProc()};
+	ProcDeclRef callee = it->second;
+	// Boogie inlines these, their specification is not meant to be used
+	if (callee->hasAttr("inline"))
+		throw Unsupported{"call to inlined procedure " + callee->getName()};
+	auto const& params = callee->getParameters();
+	auto const& rets = callee->getReturns();
+	if (params.size() != callStmt.getParams().size() || rets.size() != callStmt.getReturns().size())
+		throw Unsupported{"call to " + callee->getName()};
+
+	State pre = m_vars;
+	Env env{&m_vars, &m_old, {}};
+	for (size_t i = 0; i < params.size(); ++i)
+		env.bound.insert_or_assign(bindingName(params[i]), eval(callStmt.getParams()[i]));
+	for (auto const& req: callee->getRequires())
+		prove(eval(req->getExpr(), env),
+				SmtChecker::Failure{SmtChecker::Failure::Precondition, stmt, previous, req});
+
+	// The callee can modify the globals in its modifies clause and the returns
+	for (auto const& mod: callee->getModifies())
+		m_vars.insert_or_assign(mod, fresh(mod));
+	std::vector<Expression> results;
+	for (auto const& ret: rets)
+	{
+		results.push_back(fresh(bindingName(ret), sort(ret.type)));
+		env.bound.insert_or_assign(bindingName(ret), results.back());
+	}
+	env.old = &pre;
+	for (auto const& ens: callee->getEnsures())
+		assume(eval(ens->getExpr(), env));
+	for (size_t i = 0; i < results.size(); ++i)
+		m_vars.insert_or_assign(callStmt.getReturns()[i], results[i]);
+}
+
+void Encoder::ifElse(IfElseStmt const& stmt)
+{
+	Expression cond = stmt.getCond() ? eval(stmt.getCond()) : fresh("$cond", std::make_shared<smt::Sort>(smt::Kind::Bool));
+	Path entry = current();
+	std::vector<Path> exits;
+
+	assume(cond);
+	execBlock(*stmt.getThen());
+	if (m_reachable)
+		exits.push_back(current());
+
+	m_pc = entry.pc;
+	m_vars = entry.vars;
+	m_reachable = true;
+	assume(!cond);
+	if (stmt.getElse())
+		execBlock(*stmt.getElse());
+	if (m_reachable)
+		exits.push_back(current());
+
+	merge(exits);
+}
+
+void Encoder::loop(Stmt::Ref const& stmt)
+{
+	auto const& whileStmt = dynamic_cast<WhileStmt const&>(*stmt);
+	auto const& invariants = whileStmt.getInvariants();
+	for (auto const& inv: invariants)
+		prove(eval(inv->getExpr()), SmtChecker::Failure{SmtChecker::Failure::InvariantEntry, stmt, nullptr, inv});
+
+	// Jump to an arbitrary iteration
+	std::set<std::string> modified;
+	collectModified(*whileStmt.getBody(), modified);
+	for (auto const& var: modified)
+		m_vars.insert_or_assign(var, fresh(var));
+	for (auto const& inv: invariants)
+		assume(eval(inv->getExpr()));
+
+	Expression cond = whileStmt.getCond() ? eval(whileStmt.getCond()) : fresh("$cond", std::make_shared<smt::Sort>(smt::Kind::Bool));
+	Path entry = current();
+
+	// The iteration has to preserve the invariants
+	assume(cond);
+	execBlock(*whileStmt.getBody());
+	if (m_reachable)
+		for (auto const& inv: invariants)
+			prove(eval(inv->getExpr()), SmtChecker::Failure{SmtChecker::Failure::InvariantMaintained, stmt, nullptr, inv});
+
+	// Exit the loop (jumps out of the body are merged at their labels)
+	m_pc = entry.pc;
+	m_vars = entry.vars;
+	m_reachable = true;
+	assume(!cond);
+}
+
+void Encoder::jump(std::string const& label)
+{
+	if (m_labels.count(label))
+		throw Unsupported{"backward jump to " + label};
+	m_jumps[label].push_back(current());
+	m_reachable = false;
+}
+
+void Encoder::label(std::string const& label)
+{
+	m_labels.insert(label);
+	std::vector<Path> paths;
+	if (m_reachable)
+		paths.push_back(current());
+	auto it = m_jumps.find(label);
+	if (it != m_jumps.end())
+	{
+		paths.insert(paths.end(), it->second.begin(), it->second.end());
+		m_jumps.erase(it);
+	}
+	merge(paths);
+}
+
+void Encoder::checkPostconditions(Stmt::Ref const& stmt)
+{
+	if (!m_reachable)
+		return;
+	for (auto const& ens: m_proc->getEnsures())
+		prove(eval(ens->getExpr()), SmtChecker::Failure{SmtChecker::Failure::Postcondition, stmt, nullptr, ens});
+}
+
+void Encoder::merge(std::vector<Path> const& paths)
+{
+	if (paths.empty())
+	{
+		m_reachable = false;
+		return;
+	}
+	m_reachable = true;
+	if (paths.size() == 1)
+	{
+		m_pc = paths[0].pc;
+		m_vars = paths[0].vars;
+		return;
+	}
+
+	Expression pc = paths[0].pc;
+	for (size_t i = 1; i < paths.size(); ++i)
+		pc = pc || paths[i].pc;
+	m_pc = define("$pc", pc);
+
+	m_vars = paths[0].vars;
+	for (auto& var: m_vars)
+	{
+		bool same = true;
+		for (size_t i = 1; i < paths.size(); ++i)
+			same = same && paths[i].vars.at(var.first).id() == var.second.id();
+		if (same)
+			continue;
+		// The path conditions of the paths exclude each other, the last one is the default
+		Expression value = paths.back().vars.at(var.first);
+		for (size_t i = paths.size() - 1; i-- > 0;)
+			value = Expression::ite(paths[i].pc, paths[i].vars.at(var.first), value);
+		var.second = define(var.first, value);
+	}
+}
+
+void Encoder::collectModified(Block const& block, std::set<std::string>& vars) const
+{
+	for (auto const& stmt: block.getStatements())
+	{
+		switch (stmt->getKind())
+		{
+		case Stmt::ASSIGN:
+			for (Expr::Ref lhs: std::dynamic_pointer_cast<AssignStmt const>(stmt)->getLhs())
+			{
+				while (auto sel = std::dynamic_pointer_cast<SelExpr const>(lhs))
+					lhs = sel->getBase();
+				if (auto var = std::dynamic_pointer_cast<VarExpr const>(lhs))
+					vars.insert(var->getName());
+			}
+			break;
+		case Stmt::HAVOC:
+		{
+			auto const& havocked = std::dynamic_pointer_cast<HavocStmt const>(stmt)->getVars();
+			vars.insert(havocked.begin(), havocked.end());
+			break;
+		}
+		case Stmt::CALL:
+		{
+			auto callStmt = std::dynamic_pointer_cast<CallStmt const>(stmt);
+			vars.insert(callStmt->getReturns().begin(), callStmt->getReturns().end());
+			auto it = m_procs.find(callStmt->getProc());
+			if (it != m_procs.end())
+				vars.insert(it->second->getModifies().begin(), it->second->getModifies().end());
+			break;
+		}
+		case Stmt::IFELSE:
+		{
+			auto ifElseStmt = std::dynamic_pointer_cast<IfElseStmt const>(stmt);
+			collectModified(*ifElseStmt->getThen(), vars);
+			if (ifElseStmt->getElse())
+				collectModified(*ifElseStmt->getElse(), vars);
+			break;
+		}
+		case Stmt::WHILE:
+			collectModified(*std::dynamic_pointer_cast<WhileStmt const>(stmt)->getBody(), vars);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+}
+
+bool SmtChecker::available(std::string const& solver)
+{
+	return makeSolver(solver) != nullptr;
+}
+
+SmtChecker::Result SmtChecker::check(Program& program, ProcDeclRef const& proc) const
+{
+	auto smtSolver = makeSolver(solver);
+	if (!smtSolver)
+	{
+		Result result;
+		result.reason = "solver " + solver + " is not available";
+		return result;
+	}
+	return Encoder(*smtSolver, timeout).check(program, proc);
+}
+
+}
@@ -0,0 +1,68 @@
+//
+// This file is distributed under the MIT License. See SMACK-LICENSE for details.
+//
+#pragma once
+
+#include <libsolidity/boogie/BoogieAst.h>
+#include <libsolidity/boogie/BoogieAstDecl.h>
+#include <string>
+#include <vector>
+
+namespace boogie
+{
+
+/**
+ * Verifies a procedure of a Boogie program without Boogie: the verification
+ * conditions are generated directly from the in-memory program and checked
+ * by an SMT solver linked into the compiler (see libsolidity/formal).
+ *
+ * The procedure is executed symbolically on its structured form, keeping a
+ * path condition and the current value of each variable (in passive form,
+ * each assignment introduces a new solver variable). Each assertion is
+ * checked under the path condition and then assumed. Branches are merged
+ * after if-then-else statements and at labels (only forward jumps are
+ * supported), loops are cut with their invariants and calls are checked
+ * modularly using the specification of the callee.
+ *
+ * Only a quantifier-free fragment is supported: integers, booleans, arrays,
+ * uninterpreted types (encoded as integers) and functions without builtin
+ * definitions. Procedures outside the fragment are reported as unsupported
+ * so that the caller can fall back to Boogie.
+ */
+class SmtChecker
+{
+public:
+	enum class Outcome { Verified, Errors, Unknown, Timeout, Unsupported };
+
+	struct Failure
+	{
+		enum Kind { Assertion, Precondition, Postcondition, InvariantEntry, InvariantMaintained };
+		Kind kind;
+		Stmt::Ref stmt; // Failing assert, call, return or loop (null for the end of the procedure)
+		Stmt::Ref previous; // Statement before a failing call (null if none)
+		SpecificationRef spec; // Failing pre- or postcondition or loop invariant
+	};
+
+	struct Result
+	{
+		Outcome outcome = Outcome::Unsupported;
+		std::vector<Failure> failures;
+		unsigned obligations = 0; // Number of solver queries
+		std::string reason; // Why the procedure could not be checked
+	};
+
+	/** Creates a checker using the given solver (z3 or cvc4) with a time limit in seconds (0 for none) */
+	SmtChecker(std::string solver, unsigned timeout) : solver(solver), timeout(timeout) {}
+
+	/** Whether the given solver is linked into the compiler */
+	static bool available(std::string const& solver);
+
+	/** Checks procedure proc (with its implementation) in program, which should be a slice for proc */
+	Result check(Program& program, ProcDeclRef const& proc) const;
+
+private:
+	std::string solver;
+	unsigned timeout;
+};
+
+}
@@ -48,6 +48,16 @@ public:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
 	);
+	/// Generates the code of a contract without running the optimiser on it.
+	/// Only reads the AST, the optimiser can then be run without it by @a optimise.
+	/// @arg _metadata contains the to be injected metadata CBOR
+	void generateCode(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
+		bytes const& _metadata
+	);
+	/// Optimises the generated code (including the code of contracts created by the contract).
+	void optimise();
 	/// @returns Entire assembly.
 	eth::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Entire assembly as a shared pointer to non-const.
@@ -294,6 +294,14 @@ void ContractCompiler::appendInternalSelector(
 	//
 	// Which also means that the execution itself is not profitable
 	// unless we have at least 5 functions.
+	//
+	// Since the halves are split again by the same rule, the selector is a binary
+	// search over the sorted ids down to linear runs of at most 4 comparisons whenever
+	// _runs is large enough, so the dispatch cost grows logarithmically with n.
+	// A jump table indexed by selector bits is not used: it would need tag addresses
+	// stored as data and jump destinations that are only reached via computed jumps,
+	// neither of which the assembly and its optimiser (which removes unreferenced
+	// jump destinations) support.
 
 	// Start with some comparisons to avoid overflow, then do the actual comparison.
 	bool split = false;
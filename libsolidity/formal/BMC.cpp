@@ -31,11 +31,14 @@ BMC::BMC(
 	smt::EncodingContext& _context,
 	ErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
-	smt::SMTSolverChoice _enabledSolvers
+	smt::SMTSolverChoice _enabledSolvers,
+	unsigned _jobs,
+	shared_ptr<smt::SMTQueryCache> _cache
 ):
 	SMTEncoder(_context),
 	m_outerErrorReporter(_errorReporter),
-	m_interface(make_shared<smt::SMTPortfolio>(_smtlib2Responses, _enabledSolvers))
+	m_interface(make_shared<smt::SMTPortfolio>(_smtlib2Responses, _enabledSolvers, move(_cache))),
+	m_jobs(_jobs)
 {
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (_enabledSolvers.some())
@@ -569,8 +572,38 @@ pair<vector<smt::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets(smt::Expression const& _constraints)
 {
+	// Only the solvers linked into the binary are run concurrently,
+	// so there is nothing to gain with the SMT-LIB2 interface alone.
+	if (m_jobs == 1 || m_verificationTargets.size() < 2 || m_interface->solvers() < 2)
+	{
+		for (auto& target: m_verificationTargets)
+			checkVerificationTarget(target, _constraints);
+		return;
+	}
+
+	vector<PendingCheck> pendingChecks;
+	m_pendingChecks = &pendingChecks;
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target, _constraints);
+	m_pendingChecks = nullptr;
+
+	vector<smt::SMTPortfolio::Query> queries;
+	for (auto const& check: pendingChecks)
+		queries.emplace_back(check.query);
+	auto answers = m_interface->checkConcurrently(queries, m_jobs);
+	solAssert(answers.size() == pendingChecks.size(), "");
+	for (size_t i = 0; i < answers.size(); ++i)
+	{
+		auto& answer = answers[i];
+		smt::CheckResult result;
+		vector<string> values;
+		tie(result, values) = processAnswer([&]() {
+			if (answer.error)
+				rethrow_exception(answer.error);
+			return make_pair(answer.result, move(answer.values));
+		});
+		pendingChecks[i].report(result, values);
+	}
 }
 
 void BMC::checkVerificationTarget(VerificationTarget& _target, smt::Expression const& _constraints)
@@ -727,9 +760,6 @@ void BMC::checkCondition(
 	smt::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
 	vector<smt::Expression> expressionsToEvaluate;
 	vector<string> expressionNames;
 	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
@@ -739,9 +769,6 @@ void BMC::checkCondition(
 			expressionsToEvaluate.emplace_back(*_additionalValue);
 			expressionNames.push_back(_additionalValueName);
 		}
-	smt::CheckResult result;
-	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -758,7 +785,48 @@ void BMC::checkCondition(
 	SecondarySourceLocation secondaryLocation{};
 	secondaryLocation.append(extraComment, SourceLocation{});
 
-	switch (result)
+	auto report = [=](smt::CheckResult _result, vector<string> const& _values)
+	{
+		reportCondition(
+			_result,
+			_values,
+			expressionsToEvaluate,
+			expressionNames,
+			callStack,
+			_location,
+			_description,
+			secondaryLocation
+		);
+	};
+
+	if (m_pendingChecks)
+	{
+		m_pendingChecks->push_back({{_condition, expressionsToEvaluate}, move(report)});
+		return;
+	}
+
+	m_interface->push();
+	m_interface->addAssertion(_condition);
+	smt::CheckResult result;
+	vector<string> values;
+	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	m_interface->pop();
+
+	report(result, values);
+}
+
+void BMC::reportCondition(
+	smt::CheckResult _result,
+	vector<string> const& _values,
+	vector<smt::Expression> const& _expressionsToEvaluate,
+	vector<string> const& _expressionNames,
+	vector<SMTEncoder::CallStackEntry> const& callStack,
+	SourceLocation const& _location,
+	string const& _description,
+	SecondarySourceLocation const& _secondaryLocation
+)
+{
+	switch (_result)
 	{
 	case smt::CheckResult::SATISFIABLE:
 	{
@@ -768,11 +836,11 @@ void BMC::checkCondition(
 		{
 			std::ostringstream modelMessage;
 			modelMessage << "  for:\n";
-			solAssert(values.size() == expressionNames.size(), "");
+			solAssert(_values.size() == _expressionNames.size(), "");
 			map<string, string> sortedModel;
-			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
-					sortedModel[expressionNames.at(i)] = values.at(i);
+			for (size_t i = 0; i < _values.size(); ++i)
+				if (_expressionsToEvaluate.at(i).name() != _values.at(i))
+					sortedModel[_expressionNames.at(i)] = _values.at(i);
 
 			for (auto const& eval: sortedModel)
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
@@ -781,20 +849,20 @@ void BMC::checkCondition(
 				message.str(),
 				SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
 				.append(SMTEncoder::callStackMessage(callStack))
-				.append(move(secondaryLocation))
+				.append(SecondarySourceLocation(_secondaryLocation))
 			);
 		}
 		else
 		{
 			message << ".";
-			m_errorReporter.warning(_location, message.str(), secondaryLocation);
+			m_errorReporter.warning(_location, message.str(), _secondaryLocation);
 		}
 		break;
 	}
 	case smt::CheckResult::UNSATISFIABLE:
 		break;
 	case smt::CheckResult::UNKNOWN:
-		m_errorReporter.warning(_location, _description + " might happen here.", secondaryLocation);
+		m_errorReporter.warning(_location, _description + " might happen here.", _secondaryLocation);
 		break;
 	case smt::CheckResult::CONFLICTING:
 		m_errorReporter.warning(_location, "At least two SMT solvers provided conflicting answers. Results might not be sound.");
@@ -803,8 +871,6 @@ void BMC::checkCondition(
 		m_errorReporter.warning(_location, "Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -867,12 +933,18 @@ void BMC::checkBooleanNotConstant(
 
 pair<smt::CheckResult, vector<string>>
 BMC::checkSatisfiableAndGenerateModel(vector<smt::Expression> const& _expressionsToEvaluate)
+{
+	return processAnswer([&]() { return m_interface->check(_expressionsToEvaluate); });
+}
+
+pair<smt::CheckResult, vector<string>>
+BMC::processAnswer(function<pair<smt::CheckResult, vector<string>>()> const& _check)
 {
 	smt::CheckResult result;
 	vector<string> values;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result, values) = _check();
 	}
 	catch (smt::SolverError const& _e)
 	{
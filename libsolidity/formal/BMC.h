@@ -29,12 +29,14 @@
 
 
 #include <libsolidity/formal/EncodingContext.h>
+#include <libsolidity/formal/SMTPortfolio.h>
 #include <libsolidity/formal/SMTEncoder.h>
 #include <libsolidity/formal/SolverInterface.h>
 
 #include <libsolidity/interface/ReadFile.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <functional>
 #include <set>
 #include <string>
 #include <vector>
@@ -57,7 +59,9 @@ public:
 		smt::EncodingContext& _context,
 		langutil::ErrorReporter& _errorReporter,
 		std::map<h256, std::string> const& _smtlib2Responses,
-		smt::SMTSolverChoice _enabledSolvers
+		smt::SMTSolverChoice _enabledSolvers,
+		unsigned _jobs = 1,
+		std::shared_ptr<smt::SMTQueryCache> _cache = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources, std::set<Expression const*> _safeAssertions);
@@ -128,6 +132,9 @@ private:
 		std::pair<std::vector<smt::Expression>, std::vector<std::string>> modelExpressions;
 	};
 
+	/// Checks the verification targets of the current function or contract.
+	/// If more than one job is allowed, the targets are checked concurrently and
+	/// reported in the same order as if they were checked one after another.
 	void checkVerificationTargets(smt::Expression const& _constraints);
 	void checkVerificationTarget(VerificationTarget& _target, smt::Expression const& _constraints = smt::Expression(true));
 	void checkConstantCondition(VerificationTarget& _target);
@@ -145,7 +152,7 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Check that a condition can be satisfied, or collect the query if checks are pending.
 	void checkCondition(
 		smt::Expression _condition,
 		std::vector<CallStackEntry> const& callStack,
@@ -155,6 +162,17 @@ private:
 		std::string const& _additionalValueName = "",
 		smt::Expression const* _additionalValue = nullptr
 	);
+	/// Reports the answer of the solver to a query built by checkCondition.
+	void reportCondition(
+		smt::CheckResult _result,
+		std::vector<std::string> const& _values,
+		std::vector<smt::Expression> const& _expressionsToEvaluate,
+		std::vector<std::string> const& _expressionNames,
+		std::vector<CallStackEntry> const& callStack,
+		langutil::SourceLocation const& _location,
+		std::string const& _description,
+		langutil::SecondarySourceLocation const& _secondaryLocation
+	);
 	/// Checks that a boolean condition is not constant. Do not warn if the expression
 	/// is a literal constant.
 	/// @param _description the warning string, $VALUE will be replaced by the constant value.
@@ -167,6 +185,9 @@ private:
 	);
 	std::pair<smt::CheckResult, std::vector<std::string>>
 	checkSatisfiableAndGenerateModel(std::vector<smt::Expression> const& _expressionsToEvaluate);
+	/// @returns the answer of a solver, turning solver errors into warnings.
+	std::pair<smt::CheckResult, std::vector<std::string>>
+	processAnswer(std::function<std::pair<smt::CheckResult, std::vector<std::string>>()> const& _check);
 
 	smt::CheckResult checkSatisfiable();
 	//@}
@@ -183,7 +204,19 @@ private:
 	/// Assertions that are known to be safe.
 	std::set<Expression const*> m_safeAssertions;
 
-	std::shared_ptr<smt::SolverInterface> m_interface;
+	std::shared_ptr<smt::SMTPortfolio> m_interface;
+
+	/// Maximum number of threads used to check the targets of a function or contract.
+	unsigned m_jobs = 1;
+
+	/// A query whose answer is reported after all pending queries are checked.
+	struct PendingCheck
+	{
+		smt::SMTPortfolio::Query query;
+		std::function<void(smt::CheckResult, std::vector<std::string> const&)> report;
+	};
+	/// If set, checkCondition collects its query here instead of checking it.
+	std::vector<PendingCheck>* m_pendingChecks = nullptr;
 };
 
 }
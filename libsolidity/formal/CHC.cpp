@@ -36,22 +36,24 @@ CHC::CHC(
 	smt::EncodingContext& _context,
 	ErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
-	smt::SMTSolverChoice _enabledSolvers
+	smt::SMTSolverChoice _enabledSolvers,
+	shared_ptr<smt::SMTQueryCache> _cache
 ):
 	SMTEncoder(_context),
 #ifdef HAVE_Z3
 	m_interface(
 		_enabledSolvers.z3 ?
 		dynamic_pointer_cast<smt::CHCSolverInterface>(make_shared<smt::Z3CHCInterface>()) :
-		dynamic_pointer_cast<smt::CHCSolverInterface>(make_shared<smt::CHCSmtLib2Interface>(_smtlib2Responses))
+		dynamic_pointer_cast<smt::CHCSolverInterface>(make_shared<smt::CHCSmtLib2Interface>(_smtlib2Responses, _cache))
 	),
 #else
-	m_interface(make_shared<smt::CHCSmtLib2Interface>(_smtlib2Responses)),
+	m_interface(make_shared<smt::CHCSmtLib2Interface>(_smtlib2Responses, _cache)),
 #endif
 	m_outerErrorReporter(_errorReporter)
 {
 	(void)_smtlib2Responses;
 	(void)_enabledSolvers;
+	(void)_cache;
 }
 
 void CHC::analyze(SourceUnit const& _source)
@@ -78,7 +80,7 @@ void CHC::analyze(SourceUnit const& _source)
 	);
 	m_genesisPredicate = createSymbolicBlock(genesisSort, "genesis");
 	auto genesis = (*m_genesisPredicate)({});
-	addRule(genesis, genesis.name);
+	addRule(genesis, genesis.name());
 
 	_source.accept(*this);
 }
@@ -645,7 +647,7 @@ void CHC::connectBlocks(smt::Expression const& _from, smt::Expression const& _to
 		_from && m_context.assertions() && _constraints,
 		_to
 	);
-	addRule(edge, _from.name + "_to_" + _to.name);
+	addRule(edge, _from.name() + "_to_" + _to.name());
 }
 
 vector<smt::Expression> CHC::currentStateVariables()
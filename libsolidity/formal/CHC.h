@@ -33,6 +33,7 @@
 #include <libsolidity/formal/SMTEncoder.h>
 
 #include <libsolidity/formal/CHCSolverInterface.h>
+#include <libsolidity/formal/SMTQueryCache.h>
 
 #include <set>
 
@@ -48,7 +49,8 @@ public:
 		smt::EncodingContext& _context,
 		langutil::ErrorReporter& _errorReporter,
 		std::map<h256, std::string> const& _smtlib2Responses,
-		smt::SMTSolverChoice _enabledSolvers
+		smt::SMTSolverChoice _enabledSolvers,
+		std::shared_ptr<smt::SMTQueryCache> _cache = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -34,9 +34,13 @@ using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-CHCSmtLib2Interface::CHCSmtLib2Interface(map<h256, string> const& _queryResponses):
+CHCSmtLib2Interface::CHCSmtLib2Interface(
+	map<h256, string> const& _queryResponses,
+	shared_ptr<SMTQueryCache> _cache
+):
 	m_smtlib2(make_shared<SMTLib2Interface>(_queryResponses)),
-	m_queryResponses(_queryResponses)
+	m_queryResponses(_queryResponses),
+	m_cache(move(_cache))
 {
 	reset();
 }
@@ -49,17 +53,17 @@ void CHCSmtLib2Interface::reset()
 
 void CHCSmtLib2Interface::registerRelation(smt::Expression const& _expr)
 {
-	solAssert(_expr.sort, "");
-	solAssert(_expr.sort->kind == smt::Kind::Function, "");
-	if (!m_variables.count(_expr.name))
+	solAssert(_expr.sort(), "");
+	solAssert(_expr.sort()->kind == smt::Kind::Function, "");
+	if (!m_variables.count(_expr.name()))
 	{
-		auto fSort = dynamic_pointer_cast<FunctionSort>(_expr.sort);
+		auto fSort = dynamic_pointer_cast<FunctionSort>(_expr.sort());
 		string domain = m_smtlib2->toSmtLibSort(fSort->domain);
 		// Relations are predicates which have implicit codomain Bool.
-		m_variables.insert(_expr.name);
+		m_variables.insert(_expr.name());
 		write(
 			"(declare-rel |" +
-			_expr.name +
+			_expr.name() +
 			"| " +
 			domain +
 			")"
@@ -88,7 +92,7 @@ pair<CheckResult, vector<string>> CHCSmtLib2Interface::query(smt::Expression con
 
 	string response = querySolver(
 		m_accumulatedOutput +
-		"\n(query " + _block.name + " :print-certificate true)"
+		"\n(query " + _block.name() + " :print-certificate true)"
 	);
 
 	CheckResult result;
@@ -152,6 +156,8 @@ string CHCSmtLib2Interface::querySolver(string const& _input)
 	h256 inputHash = dev::keccak256(_input);
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	else if (auto response = m_cache ? m_cache->lookupExternal(inputHash) : nullopt)
+		return *response;
 	else
 	{
 		m_unhandledQueries.push_back(_input);
@@ -35,7 +35,12 @@ namespace smt
 class CHCSmtLib2Interface: public CHCSolverInterface
 {
 public:
-	explicit CHCSmtLib2Interface(std::map<h256, std::string> const& _queryResponses);
+	/// Responses to queries not in @a _queryResponses are looked up in @a _cache
+	/// (see SMTQueryCache::lookupExternal).
+	explicit CHCSmtLib2Interface(
+		std::map<h256, std::string> const& _queryResponses,
+		std::shared_ptr<SMTQueryCache> _cache = nullptr
+	);
 
 	void reset();
 
@@ -68,6 +73,7 @@ private:
 
 	std::map<h256, std::string> const& m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
+	std::shared_ptr<SMTQueryCache> m_cache;
 };
 
 }
@@ -20,6 +20,8 @@
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
@@ -30,6 +32,11 @@ CVC4Interface::CVC4Interface():
 	reset();
 }
 
+string CVC4Interface::identity() const
+{
+	return "cvc4-" + CVC4::Configuration::getVersionString() + "-rlimit" + to_string(resourceLimit);
+}
+
 void CVC4Interface::reset()
 {
 	m_variables.clear();
@@ -38,6 +45,12 @@ void CVC4Interface::reset()
 	m_solver.setResourceLimit(resourceLimit);
 }
 
+void CVC4Interface::setTimeout(unsigned _milliseconds)
+{
+	// Not cumulative: the limit applies to each check separately
+	m_solver.setTimeLimit(_milliseconds, false);
+}
+
 void CVC4Interface::push()
 {
 	m_solver.push();
@@ -117,18 +130,18 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
-	if (_expr.arguments.empty() && m_variables.count(_expr.name))
-		return m_variables.at(_expr.name);
+	if (_expr.arguments().empty() && m_variables.count(_expr.name()))
+		return m_variables.at(_expr.name());
 
 	vector<CVC4::Expr> arguments;
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toCVC4Expr(arg));
 
 	try
 	{
-		string const& n = _expr.name;
+		string const& n = _expr.name();
 		// Function application
-		if (!arguments.empty() && m_variables.count(_expr.name))
+		if (!arguments.empty() && m_variables.count(_expr.name()))
 			return m_context.mkExpr(CVC4::kind::APPLY_UF, m_variables.at(n), arguments);
 		// Literal
 		else if (arguments.empty())
@@ -137,7 +150,7 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 				return m_context.mkConst(true);
 			else if (n == "false")
 				return m_context.mkConst(false);
-			else if (auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort))
+			else if (auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort()))
 				return m_context.mkVar(n, cvc4Sort(*sortSort->inner));
 			else
 				try
@@ -191,7 +204,7 @@ CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 			return m_context.mkExpr(CVC4::kind::STORE, arguments[0], arguments[1], arguments[2]);
 		else if (n == "const_array")
 		{
-			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
+			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments()[0].sort());
 			solAssert(sortSort, "");
 			return m_context.mkConst(CVC4::ArrayStoreAll(cvc4Sort(*sortSort->inner), arguments[1]));
 		}
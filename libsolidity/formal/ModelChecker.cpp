@@ -25,10 +25,12 @@ using namespace dev::solidity;
 ModelChecker::ModelChecker(
 	ErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
-	smt::SMTSolverChoice _enabledSolvers
+	smt::SMTSolverChoice _enabledSolvers,
+	unsigned _bmcJobs,
+	shared_ptr<smt::SMTQueryCache> _cache
 ):
-	m_bmc(m_context, _errorReporter, _smtlib2Responses, _enabledSolvers),
-	m_chc(m_context, _errorReporter, _smtlib2Responses, _enabledSolvers),
+	m_bmc(m_context, _errorReporter, _smtlib2Responses, _enabledSolvers, _bmcJobs, _cache),
+	m_chc(m_context, _errorReporter, _smtlib2Responses, _enabledSolvers, _cache),
 	m_context()
 {
 }
@@ -46,10 +46,15 @@ class ModelChecker
 public:
 	/// @param _enabledSolvers represents a runtime choice of which SMT solvers
 	/// should be used, even if all are available. The default choice is to use all.
+	/// @param _bmcJobs is the number of threads used to check the BMC targets
+	/// of a function, 0 means the number of cores.
+	/// @param _cache stores the solver answers between runs, if set.
 	ModelChecker(
 		langutil::ErrorReporter& _errorReporter,
 		std::map<h256, std::string> const& _smtlib2Responses,
-		smt::SMTSolverChoice _enabledSolvers = smt::SMTSolverChoice::All()
+		smt::SMTSolverChoice _enabledSolvers = smt::SMTSolverChoice::All(),
+		unsigned _bmcJobs = 1,
+		std::shared_ptr<smt::SMTQueryCache> _cache = nullptr
 	);
 
 	void analyze(SourceUnit const& _sources);
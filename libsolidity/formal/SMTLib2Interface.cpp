@@ -34,8 +34,41 @@ using namespace dev;
 using namespace dev::solidity;
 using namespace dev::solidity::smt;
 
-SMTLib2Interface::SMTLib2Interface(map<h256, string> const& _queryResponses):
-	m_queryResponses(_queryResponses)
+namespace
+{
+
+/// @returns the arguments of @a _expr that are printed as terms.
+vector<smt::Expression const*> sExprArguments(smt::Expression const& _expr)
+{
+	vector<smt::Expression const*> arguments;
+	// The first argument of const_array is the sort of the array.
+	for (size_t i = _expr.name() == "const_array" ? 1 : 0; i < _expr.arguments().size(); ++i)
+		arguments.push_back(&_expr.arguments()[i]);
+	return arguments;
+}
+
+/// Appends the subexpressions of @a _expr that have arguments to @a _nodes,
+/// each once and after its arguments, and counts their parents in @a _parents.
+void collectNodes(
+	smt::Expression const& _expr,
+	vector<smt::Expression const*>& _nodes,
+	map<size_t, size_t>& _parents
+)
+{
+	for (smt::Expression const* argument: sExprArguments(_expr))
+		if (!argument->arguments().empty() && ++_parents[argument->id()] == 1)
+			collectNodes(*argument, _nodes, _parents);
+	_nodes.push_back(&_expr);
+}
+
+}
+
+SMTLib2Interface::SMTLib2Interface(
+	map<h256, string> const& _queryResponses,
+	shared_ptr<SMTQueryCache> _cache
+):
+	m_queryResponses(_queryResponses),
+	m_cache(move(_cache))
 {
 	reset();
 }
@@ -126,25 +159,74 @@ pair<CheckResult, vector<string>> SMTLib2Interface::check(vector<smt::Expression
 
 string SMTLib2Interface::toSExpr(smt::Expression const& _expr)
 {
-	if (_expr.arguments.empty())
-		return _expr.name;
+	// Subexpressions with more than one parent in the DAG of the expression
+	// are bound with let, so that each of them is printed only once.
+	vector<smt::Expression const*> nodes;
+	map<size_t, size_t> parents;
+	collectNodes(_expr, nodes, parents);
+
+	// A shared node is bound one level above the shared nodes it contains,
+	// the bindings of a level are printed in a single let.
+	map<size_t, size_t> depth;
+	map<size_t, size_t> level;
+	vector<vector<smt::Expression const*>> levels;
+	for (smt::Expression const* node: nodes)
+	{
+		size_t nodeDepth = 0;
+		for (smt::Expression const* argument: sExprArguments(*node))
+			if (level.count(argument->id()))
+				nodeDepth = max(nodeDepth, level[argument->id()]);
+			else if (depth.count(argument->id()))
+				nodeDepth = max(nodeDepth, depth[argument->id()]);
+		depth[node->id()] = nodeDepth;
+		if (node != &_expr && parents[node->id()] > 1)
+		{
+			level[node->id()] = nodeDepth + 1;
+			if (levels.size() <= nodeDepth)
+				levels.resize(nodeDepth + 1);
+			levels[nodeDepth].push_back(node);
+		}
+	}
+
+	map<size_t, string> bound;
+	string sexpr;
+	for (auto const& bindings: levels)
+	{
+		sexpr += "(let (";
+		for (smt::Expression const* node: bindings)
+		{
+			string name = "_e." + to_string(bound.size());
+			sexpr += "(" + name + " " + toSExpr(*node, bound) + ")";
+			bound[node->id()] = move(name);
+		}
+		sexpr += ") ";
+	}
+	sexpr += toSExpr(_expr, bound);
+	sexpr += string(levels.size(), ')');
+	return sexpr;
+}
+
+string SMTLib2Interface::toSExpr(smt::Expression const& _expr, map<size_t, string> const& _bound)
+{
+	if (_expr.arguments().empty())
+		return _expr.name();
 
 	std::string sexpr = "(";
-	if (_expr.name == "const_array")
+	if (_expr.name() == "const_array")
 	{
-		solAssert(_expr.arguments.size() == 2, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments.at(0).sort);
+		solAssert(_expr.arguments().size() == 2, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments().at(0).sort());
 		solAssert(sortSort, "");
 		auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		solAssert(arraySort, "");
-		sexpr += "(as const " + toSmtLibSort(*arraySort) + ") ";
-		sexpr += toSExpr(_expr.arguments.at(1));
+		sexpr += "(as const " + toSmtLibSort(*arraySort) + ")";
 	}
 	else
+		sexpr += _expr.name();
+	for (smt::Expression const* argument: sExprArguments(_expr))
 	{
-		sexpr += _expr.name;
-		for (auto const& arg: _expr.arguments)
-			sexpr += " " + toSExpr(arg);
+		auto name = _bound.find(argument->id());
+		sexpr += " " + (name != _bound.end() ? name->second : toSExpr(*argument, _bound));
 	}
 	sexpr += ")";
 	return sexpr;
@@ -195,8 +277,8 @@ string SMTLib2Interface::checkSatAndGetValuesCommand(vector<smt::Expression> con
 		for (size_t i = 0; i < _expressionsToEvaluate.size(); i++)
 		{
 			auto const& e = _expressionsToEvaluate.at(i);
-			solAssert(e.sort->kind == Kind::Int || e.sort->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
-			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort->kind == Kind::Int ? "Int" : "Bool") + ")\n";
+			solAssert(e.sort()->kind == Kind::Int || e.sort()->kind == Kind::Bool, "Invalid sort for expression to evaluate.");
+			command += "(declare-const |EVALEXPR_" + to_string(i) + "| " + (e.sort()->kind == Kind::Int ? "Int" : "Bool") + ")\n";
 			command += "(assert (= |EVALEXPR_" + to_string(i) + "| " + toSExpr(e) + "))\n";
 		}
 		command += "(check-sat)\n";
@@ -228,8 +310,11 @@ vector<string> SMTLib2Interface::parseValues(string::const_iterator _start, stri
 string SMTLib2Interface::querySolver(string const& _input)
 {
 	h256 inputHash = dev::keccak256(_input);
+	m_lastQuery = inputHash;
 	if (m_queryResponses.count(inputHash))
 		return m_queryResponses.at(inputHash);
+	else if (auto response = m_cache ? m_cache->lookupExternal(inputHash) : nullopt)
+		return *response;
 	else
 	{
 		m_unhandledQueries.push_back(_input);
@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include <libsolidity/formal/SMTQueryCache.h>
 #include <libsolidity/formal/SolverInterface.h>
 
 #include <libsolidity/interface/ReadFile.h>
@@ -27,6 +28,7 @@
 #include <boost/noncopyable.hpp>
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -41,7 +43,12 @@ namespace smt
 class SMTLib2Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	explicit SMTLib2Interface(std::map<h256, std::string> const& _queryResponses);
+	/// Responses to queries not in @a _queryResponses are looked up in @a _cache
+	/// (see SMTQueryCache::lookupExternal).
+	explicit SMTLib2Interface(
+		std::map<h256, std::string> const& _queryResponses,
+		std::shared_ptr<SMTQueryCache> _cache = nullptr
+	);
 
 	void reset() override;
 
@@ -55,7 +62,12 @@ public:
 
 	std::vector<std::string> unhandledQueries() override { return m_unhandledQueries; }
 
+	/// @returns the hash of the input of the last check, used to key the answers
+	/// of other solvers to the same query.
+	h256 const& lastQuery() const { return m_lastQuery; }
+
 	// Used by CHCSmtLib2Interface
+	/// @returns @a _expr in SMT-LIB2 format, with shared subexpressions bound by let.
 	std::string toSExpr(smt::Expression const& _expr);
 	std::string toSmtLibSort(Sort const& _sort);
 	std::string toSmtLibSort(std::vector<SortPointer> const& _sort);
@@ -67,6 +79,10 @@ private:
 
 	void write(std::string _data);
 
+	/// @returns @a _expr in SMT-LIB2 format, using the names in @a _bound
+	/// for the subexpressions with these ids.
+	std::string toSExpr(smt::Expression const& _expr, std::map<size_t, std::string> const& _bound);
+
 	std::string checkSatAndGetValuesCommand(std::vector<smt::Expression> const& _expressionsToEvaluate);
 	std::vector<std::string> parseValues(std::string::const_iterator _start, std::string::const_iterator _end);
 
@@ -78,6 +94,8 @@ private:
 
 	std::map<h256, std::string> const& m_queryResponses;
 	std::vector<std::string> m_unhandledQueries;
+	std::shared_ptr<SMTQueryCache> m_cache;
+	h256 m_lastQuery;
 };
 
 }
@@ -25,6 +25,12 @@
 #endif
 #include <libsolidity/formal/SMTLib2Interface.h>
 
+#include <libdevcore/JSON.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity;
@@ -32,37 +38,58 @@ using namespace dev::solidity::smt;
 
 SMTPortfolio::SMTPortfolio(
 	map<h256, string> const& _smtlib2Responses,
-	SMTSolverChoice _enabledSolvers
-)
+	SMTSolverChoice _enabledSolvers,
+	shared_ptr<SMTQueryCache> _cache
+):
+	m_enabledSolvers(_enabledSolvers),
+	m_cache(move(_cache))
 {
-	m_solvers.emplace_back(make_unique<smt::SMTLib2Interface>(_smtlib2Responses));
+	m_solvers.emplace_back(make_unique<smt::SMTLib2Interface>(_smtlib2Responses, m_cache));
+	for (auto& solver: linkedSolvers(_enabledSolvers))
+		m_solvers.emplace_back(move(solver));
+}
+
+vector<unique_ptr<SolverInterface>> SMTPortfolio::linkedSolvers(SMTSolverChoice _enabledSolvers)
+{
+	vector<unique_ptr<SolverInterface>> solvers;
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3)
-		m_solvers.emplace_back(make_unique<smt::Z3Interface>());
+		solvers.emplace_back(make_unique<smt::Z3Interface>());
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
-		m_solvers.emplace_back(make_unique<smt::CVC4Interface>());
+		solvers.emplace_back(make_unique<smt::CVC4Interface>());
 #endif
 	(void)_enabledSolvers;
+	return solvers;
 }
 
 void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	m_declarations.clear();
+	m_assertions.clear();
+	m_assertionFrames.clear();
+	m_workers.clear();
 }
 
 void SMTPortfolio::push()
 {
 	for (auto const& s: m_solvers)
 		s->push();
+	m_assertionFrames.push_back(m_assertions.size());
 }
 
 void SMTPortfolio::pop()
 {
 	for (auto const& s: m_solvers)
 		s->pop();
+	if (!m_assertionFrames.empty())
+	{
+		m_assertions.erase(m_assertions.begin() + m_assertionFrames.back(), m_assertions.end());
+		m_assertionFrames.pop_back();
+	}
 }
 
 void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
@@ -70,12 +97,14 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	solAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	m_declarations.emplace_back(_name, _sort);
 }
 
 void SMTPortfolio::addAssertion(smt::Expression const& _expr)
 {
 	for (auto const& s: m_solvers)
 		s->addAssertion(_expr);
+	m_assertions.push_back(_expr);
 }
 
 /*
@@ -109,14 +138,160 @@ void SMTPortfolio::addAssertion(smt::Expression const& _expr)
  *   If all solvers return ERROR, the result is ERROR.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<smt::Expression> const& _expressionsToEvaluate)
+{
+	vector<pair<CheckResult, vector<string>>> answers;
+	// The SMT-LIB2 interface comes first, it provides the key of the cached answers.
+	answers.emplace_back(m_solvers.front()->check(_expressionsToEvaluate));
+	h256 query = smtlib2().lastQuery();
+	for (size_t i = 1; i < m_solvers.size(); ++i)
+		if (auto answer = cachedAnswer(*m_solvers[i], query))
+			answers.emplace_back(move(*answer));
+		else
+		{
+			answers.emplace_back(m_solvers[i]->check(_expressionsToEvaluate));
+			storeAnswer(*m_solvers[i], query, answers.back());
+		}
+	return combine(move(answers));
+}
+
+vector<SMTPortfolio::Answer> SMTPortfolio::checkConcurrently(vector<Query> const& _queries, unsigned _jobs)
+{
+	vector<Answer> answers(_queries.size());
+	// Answers of each solver in portfolio order, unset if not known yet.
+	vector<vector<optional<pair<CheckResult, vector<string>>>>> solverAnswers(
+		_queries.size(),
+		vector<optional<pair<CheckResult, vector<string>>>>(m_solvers.size())
+	);
+	vector<h256> queryHashes(_queries.size());
+	size_t pendingQueries = 0;
+
+	// The SMT-LIB2 interface collects the unhandled queries, so it is queried in order.
+	SolverInterface& smtlib2Interface = *m_solvers.front();
+	for (size_t i = 0; i < _queries.size(); ++i)
+	{
+		smtlib2Interface.push();
+		try
+		{
+			smtlib2Interface.addAssertion(_queries[i].condition);
+			solverAnswers[i][0] = smtlib2Interface.check(_queries[i].expressionsToEvaluate);
+			queryHashes[i] = smtlib2().lastQuery();
+		}
+		catch (...)
+		{
+			answers[i].error = current_exception();
+		}
+		smtlib2Interface.pop();
+
+		if (answers[i].error)
+			continue;
+		bool pending = false;
+		for (size_t j = 1; j < m_solvers.size(); ++j)
+			if (!(solverAnswers[i][j] = cachedAnswer(*m_solvers[j], queryHashes[i])))
+				pending = true;
+		if (pending)
+			++pendingQueries;
+	}
+
+	if (pendingQueries > 0)
+	{
+		unsigned jobs = _jobs ? _jobs : max(1u, thread::hardware_concurrency());
+		jobs = min<size_t>(jobs, pendingQueries);
+		// Solvers are created on this thread, Z3 sets global parameters on construction.
+		if (m_workers.size() < jobs)
+			m_workers.resize(jobs);
+		for (size_t i = 0; i < jobs; ++i)
+			if (m_workers[i].solvers.empty())
+				m_workers[i] = Worker{linkedSolvers(m_enabledSolvers), 0};
+
+		atomic<size_t> nextQuery{0};
+		auto work = [&](Worker& _worker)
+		{
+			// The current assertions are added on top of all declarations in a frame of their own.
+			exception_ptr setupError;
+			try
+			{
+				for (auto const& solver: _worker.solvers)
+					for (size_t i = _worker.declarations; i < m_declarations.size(); ++i)
+						solver->declareVariable(m_declarations[i].first, m_declarations[i].second);
+				_worker.declarations = m_declarations.size();
+				for (auto const& solver: _worker.solvers)
+				{
+					solver->push();
+					for (auto const& assertion: m_assertions)
+						solver->addAssertion(assertion);
+				}
+			}
+			catch (...)
+			{
+				setupError = current_exception();
+			}
+
+			for (size_t i = nextQuery++; i < _queries.size(); i = nextQuery++)
+			{
+				if (answers[i].error)
+					continue;
+				// Worker solvers are in the same order as the linked solvers of the portfolio.
+				for (size_t j = 0; j < _worker.solvers.size(); ++j)
+				{
+					auto& answer = solverAnswers[i][j + 1];
+					if (answer)
+						continue;
+					if (setupError)
+					{
+						answers[i].error = setupError;
+						break;
+					}
+					SolverInterface& solver = *_worker.solvers[j];
+					solver.push();
+					try
+					{
+						solver.addAssertion(_queries[i].condition);
+						answer = solver.check(_queries[i].expressionsToEvaluate);
+						storeAnswer(solver, queryHashes[i], *answer);
+					}
+					catch (...)
+					{
+						answers[i].error = current_exception();
+					}
+					solver.pop();
+					if (answers[i].error)
+						break;
+				}
+			}
+
+			if (setupError)
+				// The state of the solvers is unknown, they are rebuilt next time.
+				_worker = Worker{};
+			else
+				for (auto const& solver: _worker.solvers)
+					solver->pop();
+		};
+
+		vector<thread> threads;
+		for (size_t i = 0; i < jobs; ++i)
+			threads.emplace_back(work, ref(m_workers[i]));
+		for (auto& thread: threads)
+			thread.join();
+	}
+
+	for (size_t i = 0; i < _queries.size(); ++i)
+		if (!answers[i].error)
+		{
+			vector<pair<CheckResult, vector<string>>> knownAnswers;
+			for (auto& answer: solverAnswers[i])
+				if (answer)
+					knownAnswers.emplace_back(move(*answer));
+			tie(answers[i].result, answers[i].values) = combine(move(knownAnswers));
+		}
+	return answers;
+}
+
+pair<CheckResult, vector<string>> SMTPortfolio::combine(vector<pair<CheckResult, vector<string>>> _answers)
 {
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (auto& [result, values]: _answers)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
@@ -137,12 +312,81 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<smt::Expression> co
 }
 
 vector<string> SMTPortfolio::unhandledQueries()
+{
+	return smtlib2().unhandledQueries();
+}
+
+SMTLib2Interface& SMTPortfolio::smtlib2()
 {
 	// This code assumes that the constructor guarantees that
 	// SmtLib2Interface is in position 0.
 	solAssert(!m_solvers.empty(), "");
-	solAssert(dynamic_cast<smt::SMTLib2Interface*>(m_solvers.front().get()), "");
-	return m_solvers.front()->unhandledQueries();
+	auto smtlib2Interface = dynamic_cast<smt::SMTLib2Interface*>(m_solvers.front().get());
+	solAssert(smtlib2Interface, "");
+	return *smtlib2Interface;
+}
+
+optional<pair<CheckResult, vector<string>>> SMTPortfolio::cachedAnswer(
+	SolverInterface const& _solver,
+	h256 const& _query
+) const
+{
+	string identity = _solver.identity();
+	if (!m_cache || identity.empty())
+		return {};
+	auto entry = m_cache->lookup(_query, identity);
+	Json::Value answer;
+	if (!entry || !jsonParseStrict(*entry, answer) || !answer["result"].isString() || !answer["values"].isArray())
+		return {};
+
+	static map<string, CheckResult> const results{
+		{"sat", CheckResult::SATISFIABLE},
+		{"unsat", CheckResult::UNSATISFIABLE},
+		{"unknown", CheckResult::UNKNOWN}
+	};
+	auto result = results.find(answer["result"].asString());
+	if (result == results.end())
+		return {};
+	vector<string> values;
+	for (auto const& value: answer["values"])
+	{
+		if (!value.isString())
+			return {};
+		values.push_back(value.asString());
+	}
+	return make_pair(result->second, move(values));
+}
+
+void SMTPortfolio::storeAnswer(
+	SolverInterface const& _solver,
+	h256 const& _query,
+	pair<CheckResult, vector<string>> const& _answer
+) const
+{
+	string identity = _solver.identity();
+	if (!m_cache || identity.empty())
+		return;
+
+	Json::Value answer(Json::objectValue);
+	switch (_answer.first)
+	{
+	case CheckResult::SATISFIABLE:
+		answer["result"] = "sat";
+		break;
+	case CheckResult::UNSATISFIABLE:
+		answer["result"] = "unsat";
+		break;
+	case CheckResult::UNKNOWN:
+		// The resource limits are part of the identity, so this is reproducible.
+		answer["result"] = "unknown";
+		break;
+	default:
+		return;
+	}
+	answer["values"] = Json::arrayValue;
+	for (string const& value: _answer.second)
+		answer["values"].append(value);
+	m_cache->store(_query, identity, jsonCompactPrint(answer));
 }
 
 bool SMTPortfolio::solverAnswered(CheckResult result)
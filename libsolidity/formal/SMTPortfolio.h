@@ -18,12 +18,15 @@
 #pragma once
 
 
+#include <libsolidity/formal/SMTQueryCache.h>
 #include <libsolidity/formal/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libdevcore/FixedHash.h>
 
 #include <boost/noncopyable.hpp>
+#include <exception>
 #include <map>
+#include <optional>
 #include <vector>
 
 namespace dev
@@ -33,18 +36,25 @@ namespace solidity
 namespace smt
 {
 
+class SMTLib2Interface;
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
  * It also checks whether different solvers give conflicting answers
  * to SMT queries.
+ * Independent queries can also be checked concurrently on copies of the
+ * solvers linked into the binary, see checkConcurrently.
+ * If a cache is given, the answers of the linked solvers are stored in it, keyed
+ * by the hash of the same query in SMT-LIB2 format, and reused in later runs.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
 public:
 	SMTPortfolio(
 		std::map<h256, std::string> const& _smtlib2Responses,
-		SMTSolverChoice _enabledSolvers
+		SMTSolverChoice _enabledSolvers,
+		std::shared_ptr<SMTQueryCache> _cache = nullptr
 	);
 
 	void reset() override;
@@ -60,12 +70,68 @@ public:
 
 	std::vector<std::string> unhandledQueries() override;
 	unsigned solvers() override { return m_solvers.size(); }
+
+	struct Query
+	{
+		/// Condition checked on top of the current assertions.
+		Expression condition;
+		std::vector<Expression> expressionsToEvaluate;
+	};
+	struct Answer
+	{
+		CheckResult result = CheckResult::ERROR;
+		std::vector<std::string> values;
+		/// Exception thrown by a solver, the result is not valid if set.
+		std::exception_ptr error;
+	};
+
+	/// Checks each of @a _queries as if it was pushed, asserted, checked and popped.
+	/// The SMT-LIB2 interface is queried in order on this thread. The solvers linked
+	/// into the binary are run on up to @a _jobs threads (0 means the number of cores),
+	/// each with its own solvers rebuilt from the declarations and assertions so far.
+	/// @returns the answers in the order of the queries.
+	std::vector<Answer> checkConcurrently(std::vector<Query> const& _queries, unsigned _jobs);
+
 private:
+	/// @returns the solvers linked into the binary that are enabled.
+	static std::vector<std::unique_ptr<smt::SolverInterface>> linkedSolvers(SMTSolverChoice _enabledSolvers);
+	/// Combines the answers of the solvers (in portfolio order) into a single answer.
+	static std::pair<CheckResult, std::vector<std::string>> combine(
+		std::vector<std::pair<CheckResult, std::vector<std::string>>> _answers
+	);
 	static bool solverAnswered(CheckResult result);
 
-	std::vector<std::unique_ptr<smt::SolverInterface>> m_solvers;
+	SMTLib2Interface& smtlib2();
+	/// @returns the cached answer of @a _solver to the query with hash @a _query, if any.
+	std::optional<std::pair<CheckResult, std::vector<std::string>>> cachedAnswer(
+		SolverInterface const& _solver,
+		h256 const& _query
+	) const;
+	/// Stores the answer of @a _solver to the query with hash @a _query unless it is an error.
+	/// Can be called from the threads of checkConcurrently.
+	void storeAnswer(
+		SolverInterface const& _solver,
+		h256 const& _query,
+		std::pair<CheckResult, std::vector<std::string>> const& _answer
+	) const;
 
+	std::vector<std::unique_ptr<smt::SolverInterface>> m_solvers;
+	SMTSolverChoice m_enabledSolvers;
+	std::shared_ptr<SMTQueryCache> m_cache;
+
+	/// Declarations in order since the last reset, used to rebuild the solvers.
+	std::vector<std::pair<std::string, SortPointer>> m_declarations;
+	/// Linked solvers used by checkConcurrently, kept between calls so that
+	/// only new declarations have to be replayed.
+	struct Worker
+	{
+		std::vector<std::unique_ptr<smt::SolverInterface>> solvers;
+		size_t declarations = 0;
+	};
+	std::vector<Worker> m_workers;
+	/// Current assertions and the number of assertions at each push.
 	std::vector<smt::Expression> m_assertions;
+	std::vector<size_t> m_assertionFrames;
 };
 
 }
@@ -0,0 +1,99 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cctype>
+#include <fstream>
+#include <iterator>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity::smt;
+namespace fs = boost::filesystem;
+
+optional<string> SMTQueryCache::lookup(h256 const& _query, string const& _solver) const
+{
+	ifstream file(entryPath(_query, _solver).string(), ios::binary);
+	if (!file)
+		return {};
+	string entry{istreambuf_iterator<char>(file), istreambuf_iterator<char>()};
+	if (file.bad())
+		return {};
+	size_t separator = entry.find('\n');
+	if (separator == string::npos)
+		return {};
+	string response = entry.substr(separator + 1);
+	if (entry.substr(0, separator) != keccak256(response).hex())
+		return {};
+	return response;
+}
+
+void SMTQueryCache::store(h256 const& _query, string const& _solver, string const& _response)
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Entries are written to a temporary file first, so that concurrent
+	// compiler runs never read a partially written response.
+	fs::path temporary = m_directory / fs::unique_path("%%%%-%%%%-%%%%-%%%%.tmp", error);
+	if (error)
+		return;
+	{
+		ofstream file(temporary.string(), ios::binary | ios::trunc);
+		file << keccak256(_response).hex() << '\n' << _response;
+		if (!file.flush())
+		{
+			file.close();
+			fs::remove(temporary, error);
+			return;
+		}
+	}
+	fs::rename(temporary, entryPath(_query, _solver), error);
+	if (error)
+		fs::remove(temporary, error);
+}
+
+optional<string> SMTQueryCache::lookupExternal(h256 const& _query) const
+{
+	if (m_externalSolver.empty())
+		return {};
+	return lookup(_query, m_externalSolver);
+}
+
+void SMTQueryCache::storeExternal(map<h256, string> const& _responses)
+{
+	if (m_externalSolver.empty())
+		return;
+	for (auto const& response: _responses)
+		if (lookup(response.first, m_externalSolver) != response.second)
+			store(response.first, m_externalSolver, response.second);
+}
+
+fs::path SMTQueryCache::entryPath(h256 const& _query, string const& _solver) const
+{
+	string name = _query.hex() + ".";
+	for (char c: _solver)
+		name += isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '-' ? c : '_';
+	return m_directory / name;
+}
@@ -0,0 +1,77 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <libdevcore/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+namespace smt
+{
+
+/**
+ * Persistent store of the responses of SMT solvers, shared between compiler runs.
+ * There is one file per query and solver in the cache directory, named after the
+ * keccak256 hash of the query in SMT-LIB2 format and the identity of the solver
+ * (see SolverInterface::identity). The file starts with the hash of the response,
+ * followed by the response, whose format is up to the solver.
+ *
+ * Responses to SMT-LIB2 queries given in the auxiliary input are cached under the
+ * identity of the external solver that produced them, if the caller names it.
+ */
+class SMTQueryCache: public boost::noncopyable
+{
+public:
+	explicit SMTQueryCache(boost::filesystem::path _directory, std::string _externalSolver = {}):
+		m_directory(std::move(_directory)), m_externalSolver(std::move(_externalSolver)) {}
+
+	/// @returns the stored response of the solver @a _solver to the query with hash @a _query,
+	/// if any. Entries that are damaged (e.g. truncated) are ignored.
+	std::optional<std::string> lookup(h256 const& _query, std::string const& _solver) const;
+	/// Stores the response of the solver @a _solver to the query with hash @a _query.
+	/// Errors are ignored, the cache only saves solver time.
+	void store(h256 const& _query, std::string const& _solver, std::string const& _response);
+
+	/// @returns the stored response of the external solver to the query with hash @a _query,
+	/// nothing if the external solver is unknown.
+	std::optional<std::string> lookupExternal(h256 const& _query) const;
+	/// Stores the responses of the external solver that are not stored yet.
+	/// Does nothing if the external solver is unknown.
+	void storeExternal(std::map<h256, std::string> const& _responses);
+
+private:
+	boost::filesystem::path entryPath(h256 const& _query, std::string const& _solver) const;
+
+	boost::filesystem::path m_directory;
+	/// Identity of the solver answering the SMT-LIB2 queries of the compiler, e.g. its
+	/// command and version. Empty if unknown.
+	std::string m_externalSolver;
+};
+
+}
+}
+}
@@ -0,0 +1,147 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolidity/formal/SolverInterface.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+using namespace std;
+using namespace dev::solidity::smt;
+
+namespace
+{
+
+/**
+ * Hash-consing table of the expression nodes and their names, shared by all threads.
+ * The table is split into shards by the hash of the nodes, each with its own lock,
+ * so that threads creating expressions rarely wait for each other.
+ * The table does not keep nodes alive. Expired nodes and unused names are removed
+ * from a shard from time to time, when it has grown to twice its size after the last sweep.
+ */
+class ExpressionTable
+{
+public:
+	static ExpressionTable& instance()
+	{
+		static ExpressionTable table;
+		return table;
+	}
+
+	shared_ptr<ExpressionNode const> intern(string const& _name, vector<Expression> _arguments, SortPointer _sort)
+	{
+		solAssert(_sort, "");
+		size_t hash = 0;
+		boost::hash_combine(hash, _name);
+		boost::hash_combine(hash, static_cast<int>(_sort->kind));
+		for (auto const& argument: _arguments)
+			boost::hash_combine(hash, argument.id());
+
+		Shard& shard = m_shards[hash % c_shards];
+		lock_guard<mutex> lock(shard.mutex);
+		auto range = shard.nodes.equal_range(hash);
+		for (auto it = range.first; it != range.second; ++it)
+			if (auto node = it->second.lock())
+				if (matches(*node, _name, _arguments, *_sort))
+					return node;
+
+		if (shard.nodes.size() >= shard.sweepThreshold)
+			shard.sweep();
+		// Not allocated with make_shared, so that expired entries do not keep the memory of the node.
+		shared_ptr<ExpressionNode const> node(new ExpressionNode{
+			m_nextId++,
+			shard.symbol(_name),
+			move(_arguments),
+			move(_sort)
+		});
+		shard.nodes.emplace(hash, node);
+		return node;
+	}
+
+private:
+	struct Shard
+	{
+		shared_ptr<string const> symbol(string const& _name)
+		{
+			auto it = symbols.find(_name);
+			if (it != symbols.end())
+				return it->second;
+			auto name = make_shared<string const>(_name);
+			symbols.emplace(*name, name);
+			return name;
+		}
+
+		void sweep()
+		{
+			for (auto it = nodes.begin(); it != nodes.end();)
+				if (it->second.expired())
+					it = nodes.erase(it);
+				else
+					++it;
+			// Names are only shared with the nodes of the shard, which are created with its lock held.
+			for (auto it = symbols.begin(); it != symbols.end();)
+				if (it->second.use_count() == 1)
+					it = symbols.erase(it);
+				else
+					++it;
+			sweepThreshold = max<size_t>(256, 2 * nodes.size());
+		}
+
+		std::mutex mutex;
+		/// Nodes by the hash of their name, sort kind and arguments.
+		unordered_multimap<size_t, weak_ptr<ExpressionNode const>> nodes;
+		/// Names of the nodes, keyed by a view of the shared string.
+		unordered_map<string_view, shared_ptr<string const>> symbols;
+		size_t sweepThreshold = 256;
+	};
+
+	static bool matches(
+		ExpressionNode const& _node,
+		string const& _name,
+		vector<Expression> const& _arguments,
+		Sort const& _sort
+	)
+	{
+		if (*_node.name != _name || _node.arguments.size() != _arguments.size())
+			return false;
+		for (size_t i = 0; i < _arguments.size(); ++i)
+			if (_node.arguments[i].id() != _arguments[i].id())
+				return false;
+		return *_node.sort == _sort;
+	}
+
+	static size_t const c_shards = 64;
+	array<Shard, c_shards> m_shards;
+	/// Identifiers are unique across the shards.
+	atomic<size_t> m_nextId{0};
+};
+
+}
+
+shared_ptr<ExpressionNode const> Expression::intern(
+	string const& _name,
+	vector<Expression> _arguments,
+	SortPointer _sort
+)
+{
+	return ExpressionTable::instance().intern(_name, move(_arguments), move(_sort));
+}
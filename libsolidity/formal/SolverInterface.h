@@ -26,6 +26,7 @@
 #include <boost/noncopyable.hpp>
 #include <cstdio>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -147,13 +148,19 @@ struct SortSort: public Sort
 // Forward declaration.
 SortPointer smtSort(solidity::Type const& _type);
 
+struct ExpressionNode;
+
 /// C++ representation of an SMTLIB2 expression.
+/// Expressions are handles to the nodes of a DAG. Nodes are hash-consed, so
+/// structurally equal expressions share a single node and copying an expression
+/// does not copy its arguments.
 class Expression
 {
 	friend class SolverInterface;
 public:
 	explicit Expression(bool _v): Expression(_v ? "true" : "false", Kind::Bool) {}
 	explicit Expression(solidity::TypePointer _type): Expression(_type->toString(), {}, std::make_shared<SortSort>(smtSort(*_type))) {}
+	explicit Expression(SortPointer _sort, std::string _name = "sort"): Expression(std::move(_name), {}, std::make_shared<SortSort>(std::move(_sort))) {}
 	Expression(size_t _number): Expression(std::to_string(_number), Kind::Int) {}
 	Expression(u256 const& _number): Expression(_number.str(), Kind::Int) {}
 	Expression(s256 const& _number): Expression(_number.str(), Kind::Int) {}
@@ -186,13 +193,13 @@ public:
 			{"store", 3},
 			{"const_array", 2}
 		};
-		return operatorsArity.count(name) && operatorsArity.at(name) == arguments.size();
+		return operatorsArity.count(name()) && operatorsArity.at(name()) == arguments().size();
 	}
 
 	static Expression ite(Expression _condition, Expression _trueValue, Expression _falseValue)
 	{
-		solAssert(*_trueValue.sort == *_falseValue.sort, "");
-		SortPointer sort = _trueValue.sort;
+		solAssert(*_trueValue.sort() == *_falseValue.sort(), "");
+		SortPointer sort = _trueValue.sort();
 		return Expression("ite", std::vector<Expression>{
 			std::move(_condition), std::move(_trueValue), std::move(_falseValue)
 		}, std::move(sort));
@@ -211,11 +218,11 @@ public:
 	/// select is the SMT representation of an array index access.
 	static Expression select(Expression _array, Expression _index)
 	{
-		solAssert(_array.sort->kind == Kind::Array, "");
-		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		solAssert(_array.sort()->kind == Kind::Array, "");
+		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		solAssert(arraySort, "");
-		solAssert(_index.sort, "");
-		solAssert(*arraySort->domain == *_index.sort, "");
+		solAssert(_index.sort(), "");
+		solAssert(*arraySort->domain == *_index.sort(), "");
 		return Expression(
 			"select",
 			std::vector<Expression>{std::move(_array), std::move(_index)},
@@ -227,13 +234,13 @@ public:
 	/// The function is pure and returns the modified array.
 	static Expression store(Expression _array, Expression _index, Expression _element)
 	{
-		solAssert(_array.sort->kind == Kind::Array, "");
-		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort);
+		solAssert(_array.sort()->kind == Kind::Array, "");
+		std::shared_ptr<ArraySort> arraySort = std::dynamic_pointer_cast<ArraySort>(_array.sort());
 		solAssert(arraySort, "");
-		solAssert(_index.sort, "");
-		solAssert(_element.sort, "");
-		solAssert(*arraySort->domain == *_index.sort, "");
-		solAssert(*arraySort->range == *_element.sort, "");
+		solAssert(_index.sort(), "");
+		solAssert(_element.sort(), "");
+		solAssert(*arraySort->domain == *_index.sort(), "");
+		solAssert(*arraySort->range == *_element.sort(), "");
 		return Expression(
 			"store",
 			std::vector<Expression>{std::move(_array), std::move(_index), std::move(_element)},
@@ -243,12 +250,12 @@ public:
 
 	static Expression const_array(Expression _sort, Expression _value)
 	{
-		solAssert(_sort.sort->kind == Kind::Sort, "");
-		auto sortSort = std::dynamic_pointer_cast<SortSort>(_sort.sort);
+		solAssert(_sort.sort()->kind == Kind::Sort, "");
+		auto sortSort = std::dynamic_pointer_cast<SortSort>(_sort.sort());
 		auto arraySort = std::dynamic_pointer_cast<ArraySort>(sortSort->inner);
 		solAssert(sortSort && arraySort, "");
-		solAssert(_value.sort, "");
-		solAssert(*arraySort->range == *_value.sort, "");
+		solAssert(_value.sort(), "");
+		solAssert(*arraySort->range == *_value.sort(), "");
 		return Expression(
 			"const_array",
 			std::vector<Expression>{std::move(_sort), std::move(_value)},
@@ -315,22 +322,25 @@ public:
 	Expression operator()(std::vector<Expression> _arguments) const
 	{
 		solAssert(
-			sort->kind == Kind::Function,
+			sort()->kind == Kind::Function,
 			"Attempted function application to non-function."
 		);
-		auto fSort = dynamic_cast<FunctionSort const*>(sort.get());
+		auto fSort = dynamic_cast<FunctionSort const*>(sort().get());
 		solAssert(fSort, "");
-		return Expression(name, std::move(_arguments), fSort->codomain);
+		return Expression(name(), std::move(_arguments), fSort->codomain);
 	}
 
-	std::string name;
-	std::vector<Expression> arguments;
-	SortPointer sort;
+	std::string const& name() const;
+	std::vector<Expression> const& arguments() const;
+	SortPointer const& sort() const;
+	/// @returns the id of the node of this expression. Structurally equal expressions
+	/// have the same id, ids of nodes that are alive at the same time are distinct.
+	size_t id() const;
 
 private:
 	/// Manual constructors, should only be used by SolverInterface and this class itself.
-	Expression(std::string _name, std::vector<Expression> _arguments, SortPointer _sort):
-		name(std::move(_name)), arguments(std::move(_arguments)), sort(std::move(_sort)) {}
+	Expression(std::string const& _name, std::vector<Expression> _arguments, SortPointer _sort):
+		m_node(intern(_name, std::move(_arguments), std::move(_sort))) {}
 	Expression(std::string _name, std::vector<Expression> _arguments, Kind _kind):
 		Expression(std::move(_name), std::move(_arguments), std::make_shared<Sort>(_kind)) {}
 
@@ -340,8 +350,33 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg)}, _kind) {}
 	Expression(std::string _name, Expression _arg1, Expression _arg2, Kind _kind):
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
+
+	/// @returns the node shared by all expressions with the given name, arguments and
+	/// an equal sort, creating it if there is none. Thread-safe.
+	static std::shared_ptr<ExpressionNode const> intern(
+		std::string const& _name,
+		std::vector<Expression> _arguments,
+		SortPointer _sort
+	);
+
+	std::shared_ptr<ExpressionNode const> m_node;
 };
 
+/// Node of the expression DAG, see Expression.
+struct ExpressionNode
+{
+	size_t id;
+	/// Interned, nodes with the same name share the string.
+	std::shared_ptr<std::string const> name;
+	std::vector<Expression> arguments;
+	SortPointer sort;
+};
+
+inline std::string const& Expression::name() const { return *m_node->name; }
+inline std::vector<Expression> const& Expression::arguments() const { return m_node->arguments; }
+inline SortPointer const& Expression::sort() const { return m_node->sort; }
+inline size_t Expression::id() const { return m_node->id; }
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -369,11 +404,19 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Limits the time of each following check to @a _milliseconds (0 means no limit),
+	/// a check running out of time is unknown. Ignored by solvers without a time limit.
+	virtual void setTimeout(unsigned _milliseconds) { (void)_milliseconds; }
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual unsigned solvers() { return 1; }
+
+	/// @returns the name and version of the solver and the settings that affect its answers,
+	/// used to key cached answers. Answers are not cached if this is empty.
+	virtual std::string identity() const { return {}; }
 };
 
 }
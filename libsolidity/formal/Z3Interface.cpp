@@ -20,6 +20,8 @@
 #include <liblangutil/Exceptions.h>
 #include <libdevcore/CommonIO.h>
 
+#include <limits>
+
 using namespace std;
 using namespace dev;
 using namespace dev::solidity::smt;
@@ -32,6 +34,18 @@ Z3Interface::Z3Interface():
 	z3::set_param("rlimit", resourceLimit);
 }
 
+string Z3Interface::identity() const
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return
+		"z3-" + to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision) +
+		"-rlimit" + to_string(resourceLimit);
+}
+
 void Z3Interface::reset()
 {
 	m_constants.clear();
@@ -39,6 +53,13 @@ void Z3Interface::reset()
 	m_solver.reset();
 }
 
+void Z3Interface::setTimeout(unsigned _milliseconds)
+{
+	z3::params params(m_context);
+	params.set("timeout", _milliseconds > 0 ? _milliseconds : numeric_limits<unsigned>::max());
+	m_solver.set(params);
+}
+
 void Z3Interface::push()
 {
 	m_solver.push();
@@ -112,15 +133,15 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
-	if (_expr.arguments.empty() && m_constants.count(_expr.name))
-		return m_constants.at(_expr.name);
+	if (_expr.arguments().empty() && m_constants.count(_expr.name()))
+		return m_constants.at(_expr.name());
 	z3::expr_vector arguments(m_context);
-	for (auto const& arg: _expr.arguments)
+	for (auto const& arg: _expr.arguments())
 		arguments.push_back(toZ3Expr(arg));
 
 	try
 	{
-		string const& n = _expr.name;
+		string const& n = _expr.name();
 		if (m_functions.count(n))
 			return m_functions.at(n)(arguments);
 		else if (m_constants.count(n))
@@ -134,9 +155,9 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 				return m_context.bool_val(true);
 			else if (n == "false")
 				return m_context.bool_val(false);
-			else if (_expr.sort->kind == Kind::Sort)
+			else if (_expr.sort()->kind == Kind::Sort)
 			{
-				auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort);
+				auto sortSort = dynamic_pointer_cast<SortSort>(_expr.sort());
 				solAssert(sortSort, "");
 				return m_context.constant(n.c_str(), z3Sort(*sortSort->inner));
 			}
@@ -188,7 +209,7 @@ z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 			return z3::store(arguments[0], arguments[1], arguments[2]);
 		else if (n == "const_array")
 		{
-			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments[0].sort);
+			shared_ptr<SortSort> sortSort = std::dynamic_pointer_cast<SortSort>(_expr.arguments()[0].sort());
 			solAssert(sortSort, "");
 			auto arraySort = dynamic_pointer_cast<ArraySort>(sortSort->inner);
 			solAssert(arraySort && arraySort->domain, "");
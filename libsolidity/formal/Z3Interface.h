@@ -43,6 +43,10 @@ public:
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
 
+	void setTimeout(unsigned _milliseconds) override;
+
+	std::string identity() const override;
+
 	z3::expr toZ3Expr(Expression const& _expr);
 
 	std::map<std::string, z3::expr> constants() const { return m_constants; }
@@ -62,11 +66,12 @@ private:
 	z3::sort z3Sort(smt::Sort const& _sort);
 	z3::sort_vector z3Sort(std::vector<smt::SortPointer> const& _sorts);
 
-	std::map<std::string, z3::expr> m_constants;
-	std::map<std::string, z3::func_decl> m_functions;
-
+	// The context is declared first so that it outlives the expressions created in it.
 	z3::context m_context;
 	z3::solver m_solver;
+
+	std::map<std::string, z3::expr> m_constants;
+	std::map<std::string, z3::func_decl> m_functions;
 };
 
 }
@@ -0,0 +1,51 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * State shared by all parts of a compilation run.
+ */
+
+#include <libsolidity/interface/CompilationContext.h>
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+CompilationContext::~CompilationContext()
+{
+	Scope scope{*this};
+	yul::YulStringRepository::reset();
+}
+
+CompilationContext::Scope::Scope(CompilationContext& _context):
+	m_ids{_context.m_ids},
+	m_types{_context.m_types},
+	m_yulStrings{_context.m_yulStrings}
+{
+}
+
+function<void()> CompilationContext::inCurrentContext(function<void()> _task)
+{
+	IDDispenser* ids = &CurrentInstance<IDDispenser>::get();
+	TypeProvider* types = &CurrentInstance<TypeProvider>::get();
+	yul::YulStringRepository* yulStrings = &yul::YulStringRepository::instance();
+	return [=, task = move(_task)]() {
+		CurrentInstance<IDDispenser>::Scope idScope{*ids};
+		CurrentInstance<TypeProvider>::Scope typeScope{*types};
+		CurrentInstance<yul::YulStringRepository>::Scope yulStringScope{*yulStrings};
+		task();
+	};
+}
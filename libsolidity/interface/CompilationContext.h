@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * State shared by all parts of a compilation run.
+ */
+
+#pragma once
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/ast/TypeProvider.h>
+#include <libyul/YulString.h>
+
+#include <libdevcore/CurrentInstance.h>
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * The AST node IDs, types and Yul strings of a compilation run.
+ *
+ * Without a context, compilations use the process-wide default instances and
+ * cannot run concurrently. A compilation that runs inside the Scope of its own
+ * context does not share any of this state with other threads, so several
+ * CompilerStacks can be used at the same time, each in its own context and thread.
+ */
+class CompilationContext: private boost::noncopyable
+{
+public:
+	CompilationContext() = default;
+	/// Drops the Yul dialects that were created for the strings of this context.
+	~CompilationContext();
+
+	/// Makes the context current on the constructing thread for the lifetime of the scope.
+	class Scope
+	{
+	public:
+		explicit Scope(CompilationContext& _context);
+
+	private:
+		CurrentInstance<IDDispenser>::Scope m_ids;
+		CurrentInstance<TypeProvider>::Scope m_types;
+		CurrentInstance<yul::YulStringRepository>::Scope m_yulStrings;
+	};
+
+	/// @returns a function that runs @a _task with the current IDs, types and Yul strings
+	/// of the calling thread. Use this to continue a compilation on another thread.
+	static std::function<void()> inCurrentContext(std::function<void()> _task);
+
+private:
+	IDDispenser m_ids;
+	TypeProvider m_types;
+	yul::YulStringRepository m_yulStrings;
+};
+
+}
+}
@@ -41,6 +41,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationContext.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
@@ -70,30 +71,45 @@
 
 #include <boost/algorithm/string.hpp>
 
+#include <condition_variable>
+#include <thread>
+
 using namespace std;
 using namespace dev;
 using namespace langutil;
 using namespace dev::solidity;
 
-static int g_compilerStackCounts = 0;
+namespace
+{
+/// Number of CompilerStacks using each TypeProvider, i.e. each CompilationContext.
+mutex g_compilerStackCountsMutex;
+map<TypeProvider const*, int> g_compilerStackCounts;
+}
 
 CompilerStack::CompilerStack(ReadCallback::Callback const& _readFile):
 	m_readFile{_readFile},
+	m_typeProvider{&CurrentInstance<TypeProvider>::get()},
 	m_generateIR{false},
 	m_generateEWasm{false},
 	m_errorList{},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
+	// Because TypeProvider is a singleton API within a compilation context, we must ensure
+	// that no more than one entity is actually using it at a time.
+	lock_guard<mutex> lock(g_compilerStackCountsMutex);
+	solAssert(g_compilerStackCounts[m_typeProvider] == 0, "You shall not have another CompilerStack aside me.");
+	++g_compilerStackCounts[m_typeProvider];
 }
 
 CompilerStack::~CompilerStack()
 {
-	--g_compilerStackCounts;
-	TypeProvider::reset();
+	{
+		CurrentInstance<TypeProvider>::Scope types(*m_typeProvider);
+		TypeProvider::reset();
+	}
+	lock_guard<mutex> lock(g_compilerStackCountsMutex);
+	if (--g_compilerStackCounts[m_typeProvider] == 0)
+		g_compilerStackCounts.erase(m_typeProvider);
 }
 
 std::optional<CompilerStack::Remapping> CompilerStack::parseRemapping(string const& _remapping)
@@ -173,6 +189,7 @@ void CompilerStack::reset(bool _keepSettings)
 	m_hasError = false;
 	m_sources.clear();
 	m_smtlib2Responses.clear();
+	m_smtlib2Solver.clear();
 	m_unhandledSMTLib2Queries.clear();
 	if (!_keepSettings)
 	{
@@ -181,6 +198,9 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_generateIR = false;
 		m_generateEWasm = false;
+		m_compilationJobs = 1;
+		m_modelCheckerJobs = 1;
+		m_smtQueryCacheDirectory.clear();
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 	}
@@ -372,7 +392,20 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses);
+			shared_ptr<smt::SMTQueryCache> smtQueryCache;
+			if (!m_smtQueryCacheDirectory.empty())
+			{
+				smtQueryCache = make_shared<smt::SMTQueryCache>(m_smtQueryCacheDirectory, m_smtlib2Solver);
+				// Stored once here instead of whenever a query is answered
+				smtQueryCache->storeExternal(m_smtlib2Responses);
+			}
+			ModelChecker modelChecker(
+				m_errorReporter,
+				m_smtlib2Responses,
+				smt::SMTSolverChoice::All(),
+				m_modelCheckerJobs,
+				smtQueryCache
+			);
 			for (Source const* source: m_sourceOrder)
 				modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
@@ -435,18 +468,28 @@ bool CompilerStack::compile()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
 	// Only compile contracts individually which have been requested.
+	// Contracts compiled by an earlier call are not compiled again.
 	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	for (auto const& contract: m_contracts)
+		if (contract.second.compiler)
+			otherCompilers[contract.second.contract] = contract.second.compiler;
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
-				{
-					compileContract(*contract, otherCompilers);
-					if (m_generateIR || m_generateEWasm)
-						generateIR(*contract);
-					if (m_generateEWasm)
-						generateEWasm(*contract);
-				}
+					requestedContracts.push_back(contract);
+
+	if (m_compilationJobs != 1)
+		compileContractsInParallel(requestedContracts, otherCompilers);
+	for (auto const* contract: requestedContracts)
+	{
+		compileContract(*contract, otherCompilers);
+		if (m_generateIR || m_generateEWasm)
+			generateIR(*contract);
+		if (m_generateEWasm)
+			generateEWasm(*contract);
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -775,6 +818,14 @@ Scanner const& CompilerStack::scanner(string const& _sourceName) const
 	return *source(_sourceName).scanner;
 }
 
+h256 const& CompilerStack::sourceHash(string const& _sourceName) const
+{
+	if (m_stackState < SourcesSet)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("No sources set."));
+
+	return source(_sourceName).keccak256();
+}
+
 SourceUnit const& CompilerStack::ast(string const& _sourceName) const
 {
 	if (m_stackState < ParsingPerformed)
@@ -985,20 +1036,163 @@ void CompilerStack::compileContract(
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 		compileContract(*dependency, _otherCompilers);
 
+	_otherCompilers[&_contract] = compileSingleContract(_contract, _otherCompilers);
+}
+
+void CompilerStack::compileContractsInParallel(
+	vector<ContractDefinition const*> const& _contracts,
+	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
+)
+{
+	// The contracts in the order they are compiled serially (dependencies first).
+	vector<ContractDefinition const*> order;
+	map<ContractDefinition const*, size_t> indices;
+	function<void(ContractDefinition const&)> addContract = [&](ContractDefinition const& _contract)
+	{
+		if (indices.count(&_contract) || _otherCompilers.count(&_contract) || !_contract.canBeDeployed())
+			return;
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			addContract(*dependency);
+		indices[&_contract] = order.size();
+		order.push_back(&_contract);
+	};
+	for (auto const* contract: _contracts)
+		addContract(*contract);
+	if (order.empty())
+		return;
+
+	// The code of the contracts created by a contract is embedded in its code and it is
+	// optimised again with it. Contracts embedding the same code are therefore compiled in
+	// the serial order, so that the result does not depend on the schedule.
+	vector<set<size_t>> embedded(order.size());
+	vector<set<size_t>> predecessors(order.size());
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		for (auto const* dependency: order[i]->annotation().contractDependencies)
+			if (indices.count(dependency))
+			{
+				size_t j = indices.at(dependency);
+				predecessors[i].insert(j);
+				embedded[i].insert(j);
+				embedded[i].insert(embedded[j].begin(), embedded[j].end());
+			}
+		for (size_t j = 0; j < i; ++j)
+			for (size_t k: embedded[i])
+				if (embedded[j].count(k))
+				{
+					predecessors[i].insert(j);
+					break;
+				}
+	}
+	vector<vector<size_t>> successors(order.size());
+	vector<size_t> waitingFor(order.size());
+	set<size_t> ready;
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		for (size_t j: predecessors[i])
+			successors[j].push_back(i);
+		waitingFor[i] = predecessors[i].size();
+		if (waitingFor[i] == 0)
+			ready.insert(i);
+	}
+
+	mutex codegenMutex;
+	mutex scheduleMutex;
+	condition_variable scheduleChanged;
+	size_t finished = 0;
+	vector<exception_ptr> errors(order.size());
+	bool failed = false;
+
+	auto work = [&]()
+	{
+		unique_lock<mutex> lock(scheduleMutex);
+		while (true)
+		{
+			scheduleChanged.wait(lock, [&]() { return failed || finished == order.size() || !ready.empty(); });
+			if (failed || finished == order.size())
+				return;
+			size_t index = *ready.begin();
+			ready.erase(ready.begin());
+			lock.unlock();
+
+			shared_ptr<Compiler const> compiler;
+			try
+			{
+				map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+				{
+					lock_guard<mutex> codegenLock(codegenMutex);
+					otherCompilers = _otherCompilers;
+				}
+				compiler = compileSingleContract(*order[index], otherCompilers, &codegenMutex);
+				lock_guard<mutex> codegenLock(codegenMutex);
+				_otherCompilers[order[index]] = compiler;
+			}
+			catch (...)
+			{
+				errors[index] = current_exception();
+			}
+
+			lock.lock();
+			++finished;
+			if (errors[index])
+				failed = true;
+			else
+				for (size_t successor: successors[index])
+					if (--waitingFor[successor] == 0)
+						ready.insert(successor);
+			scheduleChanged.notify_all();
+		}
+	};
+
+	unsigned jobs = m_compilationJobs ? m_compilationJobs : max(1u, thread::hardware_concurrency());
+	vector<thread> workers;
+	for (size_t i = 0; i < min<size_t>(jobs, order.size()); ++i)
+		workers.emplace_back(CompilationContext::inCurrentContext(work));
+	for (auto& worker: workers)
+		worker.join();
+
+	// Report the error of the first contract in the serial order.
+	for (auto const& error: errors)
+		if (error)
+			rethrow_exception(error);
+}
+
+shared_ptr<Compiler const> CompilerStack::compileSingleContract(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers,
+	mutex* _codegenMutex
+)
+{
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_optimiserSettings);
 	compiledContract.compiler = compiler;
 
-	bytes cborEncodedMetadata = createCBORMetadata(
-		metadata(compiledContract),
-		!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
-	);
+	{
+		unique_lock<mutex> codegenLock;
+		if (_codegenMutex)
+			codegenLock = unique_lock<mutex>(*_codegenMutex);
+
+		bytes cborEncodedMetadata = createCBORMetadata(
+			metadata(compiledContract),
+			!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
+		);
+
+		try
+		{
+			// Compile the contract.
+			compiler->generateCode(_contract, _otherCompilers, cborEncodedMetadata);
+		}
+		catch(eth::OptimizerException const&)
+		{
+			solAssert(false, "Optimizer exception during compilation");
+		}
+	}
 
 	try
 	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+		// Run optimiser.
+		compiler->optimise();
 	}
 	catch(eth::OptimizerException const&)
 	{
@@ -1025,7 +1219,7 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
-	_otherCompilers[compiledContract.contract] = compiler;
+	return compiler;
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -41,6 +41,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -73,6 +74,7 @@ class Compiler;
 class GlobalContext;
 class Natspec;
 class DeclarationContainer;
+class TypeProvider;
 
 /**
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
@@ -80,6 +82,8 @@ class DeclarationContainer;
  * before compilation to bytecode) or run the whole compilation in one call.
  * If error recovery is active, it is possible to progress through the stages even when
  * there are errors. In any case, producing code is only possible without errors.
+ * Only one CompilerStack at a time can use a CompilationContext (or the default state
+ * if there is none); CompilerStacks in different contexts can be used concurrently.
  */
 class CompilerStack: boost::noncopyable
 {
@@ -167,6 +171,18 @@ public:
 	/// Enable experimental generation of eWasm code. If enabled, IR is also generated.
 	void enableEWasmGeneration(bool _enable = true) { m_generateEWasm = _enable; }
 
+	/// Sets the number of contracts compiled in parallel, 0 means the number of cores.
+	/// The bytecode does not depend on the number of jobs.
+	void setCompilationJobs(unsigned _jobs = 1) { m_compilationJobs = _jobs; }
+
+	/// Sets the number of threads used by the SMTChecker to check the targets of a function,
+	/// 0 means the number of cores. Only solvers linked into the binary are run in parallel.
+	void setModelCheckerJobs(unsigned _jobs = 1) { m_modelCheckerJobs = _jobs; }
+
+	/// Sets the directory where the SMTChecker keeps the answers of the SMT solvers
+	/// between runs. No answers are kept if @a _directory is empty.
+	void setSMTQueryCache(std::string const& _directory = "") { m_smtQueryCacheDirectory = _directory; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -178,6 +194,10 @@ public:
 	/// Must be set before parsing.
 	void addSMTLib2Response(h256 const& _hash, std::string const& _response);
 
+	/// Names the solver answering the SMTLib2 queries, e.g. its command and version.
+	/// Its responses are only kept in the SMT query cache if it is named.
+	void setSMTLib2Solver(std::string const& _solver) { m_smtlib2Solver = _solver; }
+
 	/// Parses all source units that were added
 	/// @returns false on error.
 	bool parse();
@@ -192,6 +212,8 @@ public:
 	bool parseAndAnalyze();
 
 	/// Compiles the source units that were previously added and parsed.
+	/// Can be called again with different requested contracts, in which case only the
+	/// contracts that have not been compiled yet are compiled.
 	/// @returns false on error.
 	bool compile();
 
@@ -205,6 +227,9 @@ public:
 	/// @returns the previously used scanner, useful for counting lines during error reporting.
 	langutil::Scanner const& scanner(std::string const& _sourceName) const;
 
+	/// @returns the Keccak-256 hash of the content of the given source.
+	h256 const& sourceHash(std::string const& _sourceName) const;
+
 	/// @returns the parsed source unit with the supplied name.
 	SourceUnit const& ast(std::string const& _sourceName) const;
 
@@ -353,6 +378,22 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Compiles the given contracts (and the contracts they create) using a pool of threads.
+	/// Code generation is serialised, the optimiser and the assembler of independent contracts
+	/// run in parallel. Contracts creating the same contracts are compiled in the serial order.
+	void compileContractsInParallel(
+		std::vector<ContractDefinition const*> const& _contracts,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
+	);
+
+	/// Generates, optimises and assembles the code of a single contract whose dependencies are
+	/// already compiled. Code generation is done while holding @a _codegenMutex (if given).
+	std::shared_ptr<Compiler const> compileSingleContract(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
+		std::mutex* _codegenMutex = nullptr
+	);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -413,11 +454,16 @@ private:
 	) const;
 
 	ReadCallback::Callback m_readFile;
+	/// The types of the context the stack was created in, used by no other stack.
+	TypeProvider* m_typeProvider;
 	OptimiserSettings m_optimiserSettings;
 	langutil::EVMVersion m_evmVersion;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateIR;
 	bool m_generateEWasm;
+	unsigned m_compilationJobs = 1;
+	unsigned m_modelCheckerJobs = 1;
+	std::string m_smtQueryCacheDirectory;
 	std::map<std::string, h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -425,6 +471,7 @@ private:
 	std::map<std::string const, Source> m_sources;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<h256, std::string> m_smtlib2Responses;
+	std::string m_smtlib2Solver;
 	std::shared_ptr<GlobalContext> m_globalContext;
 	std::vector<Source const*> m_sourceOrder;
 	/// This is updated during compilation.
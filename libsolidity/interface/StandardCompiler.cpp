@@ -22,6 +22,7 @@
 
 #include <libsolidity/interface/StandardCompiler.h>
 
+#include <libsolidity/interface/CompilationContext.h>
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libyul/AssemblyStack.h>
 #include <libyul/Exceptions.h>
@@ -345,7 +346,7 @@ std::optional<Json::Value> checkSourceKeys(Json::Value const& _input, string con
 
 std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 {
-	static set<string> keys{"smtlib2responses"};
+	static set<string> keys{"smtlib2responses", "smtlib2solver"};
 	return checkKeys(_input, keys, "auxiliaryInput");
 }
 
@@ -490,6 +491,64 @@ boost::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Valu
 	return { std::move(settings) };
 }
 
+/// @returns a hash of everything in @a _input that the analysis and compilation of
+/// the @a _sources depend on. The output selection only matters through the sources
+/// it selects, as only those and their imports are analysed.
+h256 compilationKey(Json::Value const& _input, map<string, string> const& _sources, Json::Value const& _outputSelection)
+{
+	Json::Value settings = _input.get("settings", Json::Value());
+	settings.removeMember("outputSelection");
+	string key = jsonCompactPrint(settings) + '\0' + jsonCompactPrint(_input.get("auxiliaryInput", Json::Value())) + '\0';
+	for (auto const& source: requestedContractNames(_outputSelection))
+		key += source.first + '\0';
+	for (auto const& source: _sources)
+		key += source.first + '\0' + keccak256(source.second).hex() + '\0';
+	return keccak256(key);
+}
+
+}
+
+/// A kept Solidity compilation, see StandardCompiler::setCompilationCacheSize.
+struct StandardCompiler::Compilation
+{
+	~Compilation()
+	{
+		// The types and Yul strings of the compiler stack belong to the context.
+		CompilationContext::Scope scope{context};
+		compilerStack.reset();
+	}
+
+	h256 key;
+	/// Hashes of the sources that were loaded through the read callback for imports.
+	map<string, h256> importedSources;
+	CompilationContext context;
+	unique_ptr<CompilerStack> compilerStack;
+};
+
+StandardCompiler::StandardCompiler(ReadCallback::Callback const& _readFile):
+	m_readFile(_readFile)
+{
+}
+
+StandardCompiler::~StandardCompiler() = default;
+
+unique_ptr<StandardCompiler::Compilation> StandardCompiler::takeCompilation(h256 const& _key)
+{
+	auto it = find_if(m_compilations.begin(), m_compilations.end(), [&](auto const& _compilation) {
+		return _compilation->key == _key;
+	});
+	if (it == m_compilations.end())
+		return nullptr;
+
+	unique_ptr<Compilation> compilation = move(*it);
+	m_compilations.erase(it);
+	for (auto const& source: compilation->importedSources)
+	{
+		ReadCallback::Result result = m_readFile ? m_readFile(source.first) : ReadCallback::Result{false, ""};
+		if (!result.success || keccak256(result.responseOrErrorMessage) != source.second)
+			return nullptr;
+	}
+	return compilation;
 }
 
 boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
@@ -619,6 +678,14 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 				ret.smtLib2Responses[hash] = smtlib2Responses[hashString].asString();
 			}
 		}
+
+		Json::Value const& smtlib2Solver = auxInputs["smtlib2solver"];
+		if (!!smtlib2Solver)
+		{
+			if (!smtlib2Solver.isString())
+				return formatFatalError("JSONError", "\"auxiliaryInput.smtlib2solver\" must be a string.");
+			ret.smtLib2Solver = smtlib2Solver.asString();
+		}
 	}
 
 	Json::Value const& settings = _input.get("settings", Json::Value());
@@ -718,6 +785,8 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 	if (auto jsonError = checkOutputSelection(outputSelection))
 		return *jsonError;
 
+	if (m_compilationCacheSize > 0)
+		ret.compilationKey = compilationKey(_input, ret.sources, outputSelection);
 	ret.outputSelection = std::move(outputSelection);
 
 	return { std::move(ret) };
@@ -725,18 +794,35 @@ boost::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompile
 
 Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
 {
-	CompilerStack compilerStack(m_readFile);
+	unique_ptr<Compilation> compilation;
+	if (m_compilationCacheSize > 0)
+		compilation = takeCompilation(_inputsAndSettings.compilationKey);
+	bool const reused = !!compilation;
+	if (!reused)
+	{
+		compilation = make_unique<Compilation>();
+		compilation->key = _inputsAndSettings.compilationKey;
+	}
+	CompilationContext::Scope scope{compilation->context};
 
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
-	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
-		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
-	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
-	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
-	compilerStack.setRemappings(_inputsAndSettings.remappings);
-	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
-	compilerStack.setLibraries(_inputsAndSettings.libraries);
-	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+	if (!reused)
+	{
+		compilation->compilerStack = make_unique<CompilerStack>(m_readFile);
+		CompilerStack& compilerStack = *compilation->compilerStack;
+		compilerStack.setSources(sourceList);
+		for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
+			compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+		compilerStack.setSMTLib2Solver(_inputsAndSettings.smtLib2Solver);
+		compilerStack.setSMTQueryCache(m_smtQueryCacheDirectory);
+		compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+		compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
+		compilerStack.setRemappings(_inputsAndSettings.remappings);
+		compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+		compilerStack.setLibraries(_inputsAndSettings.libraries);
+		compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+	}
+	CompilerStack& compilerStack = *compilation->compilerStack;
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
 
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
@@ -747,11 +833,12 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 
 	bool const binariesRequested = isBinaryRequested(_inputsAndSettings.outputSelection);
 
+	bool completed = false;
 	try
 	{
 		if (binariesRequested)
 			compilerStack.compile();
-		else
+		else if (compilerStack.state() < CompilerStack::State::AnalysisPerformed)
 			compilerStack.parseAndAnalyze();
 
 		for (auto const& error: compilerStack.errors())
@@ -766,6 +853,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 				""
 			));
 		}
+		completed = true;
 	}
 	/// This is only thrown in a very few locations.
 	catch (Error const& _error)
@@ -971,6 +1059,22 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	if (!contractsOutput.empty())
 		output["contracts"] = contractsOutput;
 
+	if (
+		m_compilationCacheSize > 0 &&
+		completed &&
+		compilerStack.state() >= CompilerStack::State::AnalysisPerformed &&
+		!compilerStack.hasError()
+	)
+	{
+		if (!reused)
+			for (string const& sourceName: compilerStack.sourceNames())
+				if (!sourceList.count(sourceName))
+					compilation->importedSources[sourceName] = compilerStack.sourceHash(sourceName);
+		m_compilations.push_front(std::move(compilation));
+		if (m_compilations.size() > m_compilationCacheSize)
+			m_compilations.pop_back();
+	}
+
 	return output;
 }
 
@@ -1053,7 +1157,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	CompilationContext context;
+	CompilationContext::Scope scope{context};
 
 	try
 	{
@@ -24,6 +24,8 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <list>
+#include <memory>
 #include <optional>
 #include <boost/variant.hpp>
 
@@ -43,10 +45,8 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback to used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit StandardCompiler(ReadCallback::Callback const& _readFile = ReadCallback::Callback()):
-		m_readFile(_readFile)
-	{
-	}
+	explicit StandardCompiler(ReadCallback::Callback const& _readFile = ReadCallback::Callback());
+	~StandardCompiler();
 
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
@@ -55,7 +55,19 @@ public:
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
 
+	/// Sets the directory where the SMTChecker keeps the answers of the SMT solvers
+	/// between runs, see CompilerStack::setSMTQueryCache.
+	void setSMTQueryCache(std::string const& _directory) { m_smtQueryCacheDirectory = _directory; }
+
+	/// Keeps the analysed and compiled state of the last @a _compilations Solidity inputs.
+	/// An input with the same sources and settings as one of them, except for the output
+	/// selection, reuses it and only compiles the contracts that were not compiled before.
+	/// The sources loaded for imports must not have changed either.
+	void setCompilationCacheSize(size_t _compilations) { m_compilationCacheSize = _compilations; }
+
 private:
+	struct Compilation;
+
 	struct InputsAndSettings
 	{
 		std::string language;
@@ -63,12 +75,16 @@ private:
 		bool parserErrorRecovery = false;
 		std::map<std::string, std::string> sources;
 		std::map<h256, std::string> smtLib2Responses;
+		std::string smtLib2Solver;
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		OptimiserSettings optimiserSettings = OptimiserSettings::minimal();
 		std::map<std::string, h160> libraries;
 		bool metadataLiteralSources = false;
 		Json::Value outputSelection;
+		/// Hash of the sources and of all settings except the output selection,
+		/// only computed if compilations are kept.
+		h256 compilationKey;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
@@ -78,7 +94,15 @@ private:
 	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
+	/// Removes the kept compilation with the given key and returns it, unless a source it
+	/// loaded for an import has changed since.
+	std::unique_ptr<Compilation> takeCompilation(h256 const& _key);
+
 	ReadCallback::Callback m_readFile;
+	std::string m_smtQueryCacheDirectory;
+	size_t m_compilationCacheSize = 0;
+	/// The kept compilations, most recently used first.
+	std::list<std::unique_ptr<Compilation>> m_compilations;
 };
 
 }
@@ -62,9 +62,10 @@ shared_ptr<Block> Parser::parse(std::shared_ptr<Scanner> const& _scanner, bool _
 std::map<string, dev::eth::Instruction> const& Parser::instructions()
 {
 	// Allowed instructions, lowercase names.
-	static map<string, dev::eth::Instruction> s_instructions;
-	if (s_instructions.empty())
+	// Initialised once in a thread-safe way, compilations can run concurrently.
+	static map<string, dev::eth::Instruction> const s_instructions = []()
 	{
+		map<string, dev::eth::Instruction> instructions;
 		for (auto const& instruction: dev::eth::c_instructions)
 		{
 			if (
@@ -74,9 +75,10 @@ std::map<string, dev::eth::Instruction> const& Parser::instructions()
 				continue;
 			string name = instruction.first;
 			transform(name.begin(), name.end(), name.begin(), [](unsigned char _c) { return tolower(_c); });
-			s_instructions[name] = instruction.second;
+			instructions[name] = instruction.second;
 		}
-	}
+		return instructions;
+	}();
 	return s_instructions;
 }
 
@@ -364,15 +366,16 @@ Expression Parser::parseExpression()
 
 std::map<dev::eth::Instruction, string> const& Parser::instructionNames()
 {
-	static map<dev::eth::Instruction, string> s_instructionNames;
-	if (s_instructionNames.empty())
+	static map<dev::eth::Instruction, string> const s_instructionNames = []()
 	{
+		map<dev::eth::Instruction, string> names;
 		for (auto const& instr: instructions())
-			s_instructionNames[instr.second] = instr.first;
+			names[instr.second] = instr.first;
 		// set the ambiguous instructions to a clear default
-		s_instructionNames[dev::eth::Instruction::SELFDESTRUCT] = "selfdestruct";
-		s_instructionNames[dev::eth::Instruction::KECCAK256] = "keccak256";
-	}
+		names[dev::eth::Instruction::SELFDESTRUCT] = "selfdestruct";
+		names[dev::eth::Instruction::KECCAK256] = "keccak256";
+		return names;
+	}();
 	return s_instructionNames;
 }
 
@@ -20,10 +20,13 @@
 
 #pragma once
 
+#include <libdevcore/CurrentInstance.h>
+
 #include <boost/noncopyable.hpp>
 
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -35,6 +38,7 @@ namespace yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+/// YulStrings refer to the repository that is current on their thread, see dev::CurrentInstance.
 class YulStringRepository
 {
 public:
@@ -44,10 +48,11 @@ public:
 		std::uint64_t hash;
 	};
 
+	YulStringRepository() = default;
+
 	static YulStringRepository& instance()
 	{
-		static YulStringRepository inst;
-		return inst;
+		return dev::CurrentInstance<YulStringRepository>::get();
 	}
 
 	Handle stringToHandle(std::string const& _string)
@@ -80,13 +85,19 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
-	/// Clear the repository.
+	/// Clear the current repository.
 	/// Use with care - there cannot be any dangling YulString references.
 	/// If references need to be cleared manually, register the callback via
-	/// resetCallback.
+	/// resetCallback. The callbacks are called while the repository being
+	/// cleared is still the current one.
 	static void reset()
 	{
-		for (auto const& cb: resetCallbacks())
+		std::vector<std::function<void()>> callbacks;
+		{
+			std::lock_guard<std::mutex> lock(resetCallbacksMutex());
+			callbacks = resetCallbacks();
+		}
+		for (auto const& cb: callbacks)
 			cb();
 		instance() = YulStringRepository{};
 	}
@@ -96,12 +107,12 @@ public:
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
+			std::lock_guard<std::mutex> lock(resetCallbacksMutex());
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
-	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
 	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
@@ -112,6 +123,11 @@ private:
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::mutex& resetCallbacksMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
 
 	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
 	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
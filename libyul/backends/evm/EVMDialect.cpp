@@ -34,6 +34,8 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <mutex>
+
 using namespace std;
 using namespace dev;
 using namespace yul;
@@ -166,6 +168,37 @@ map<YulString, BuiltinFunctionForEVM> createBuiltins(langutil::EVMVersion _evmVe
 	return builtins;
 }
 
+/// Dialects of one kind for each YulStringRepository and EVM version.
+/// The dialects of a repository are dropped when the repository is reset.
+class DialectCache
+{
+public:
+	EVMDialect const& get(AsmFlavour _flavour, bool _objectAccess, langutil::EVMVersion _version)
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto& dialect = m_dialects[{&YulStringRepository::instance(), _version}];
+		if (!dialect)
+			dialect = make_unique<EVMDialect>(_flavour, _objectAccess, _version);
+		return *dialect;
+	}
+
+private:
+	void clear()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		YulStringRepository const* repository = &YulStringRepository::instance();
+		for (auto it = m_dialects.begin(); it != m_dialects.end();)
+			if (it->first.first == repository)
+				it = m_dialects.erase(it);
+			else
+				++it;
+	}
+
+	mutex m_mutex;
+	map<pair<YulStringRepository const*, langutil::EVMVersion>, unique_ptr<EVMDialect const>> m_dialects;
+	YulStringRepository::ResetCallback m_callback{[this] { clear(); }};
+};
+
 }
 
 EVMDialect::EVMDialect(AsmFlavour _flavour, bool _objectAccess, langutil::EVMVersion _evmVersion):
@@ -187,38 +220,26 @@ BuiltinFunctionForEVM const* EVMDialect::builtin(YulString _name) const
 
 EVMDialect const& EVMDialect::looseAssemblyForEVM(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Loose, false, _version);
-	return *dialects[_version];
+	static DialectCache dialects;
+	return dialects.get(AsmFlavour::Loose, false, _version);
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVM(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Strict, false, _version);
-	return *dialects[_version];
+	static DialectCache dialects;
+	return dialects.get(AsmFlavour::Strict, false, _version);
 }
 
 EVMDialect const& EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Strict, true, _version);
-	return *dialects[_version];
+	static DialectCache dialects;
+	return dialects.get(AsmFlavour::Strict, true, _version);
 }
 
 EVMDialect const& EVMDialect::yulForEVM(langutil::EVMVersion _version)
 {
-	static map<langutil::EVMVersion, unique_ptr<EVMDialect const>> dialects;
-	static YulStringRepository::ResetCallback callback{[&] { dialects.clear(); }};
-	if (!dialects[_version])
-		dialects[_version] = make_unique<EVMDialect>(AsmFlavour::Yul, false, _version);
-	return *dialects[_version];
+	static DialectCache dialects;
+	return dialects.get(AsmFlavour::Yul, false, _version);
 }
 
 SideEffects EVMDialect::sideEffectsOfInstruction(eth::Instruction _instruction)
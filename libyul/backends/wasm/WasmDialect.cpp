@@ -20,6 +20,9 @@
 
 #include <libyul/backends/wasm/WasmDialect.h>
 
+#include <map>
+#include <mutex>
+
 using namespace std;
 using namespace yul;
 
@@ -90,8 +93,15 @@ BuiltinFunction const* WasmDialect::builtin(YulString _name) const
 
 WasmDialect const& WasmDialect::instance()
 {
-	static std::unique_ptr<WasmDialect> dialect;
-	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	// One dialect for each YulStringRepository, dropped when the repository is reset.
+	static map<YulStringRepository const*, unique_ptr<WasmDialect>> dialects;
+	static mutex dialectsMutex;
+	static YulStringRepository::ResetCallback callback{[&] {
+		lock_guard<mutex> lock(dialectsMutex);
+		dialects.erase(&YulStringRepository::instance());
+	}};
+	lock_guard<mutex> lock(dialectsMutex);
+	auto& dialect = dialects[&YulStringRepository::instance()];
 	if (!dialect)
 		dialect = make_unique<WasmDialect>();
 	return *dialect;
@@ -46,11 +46,16 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static SimplificationRules rules;
+	static thread_local SimplificationRules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	rules.m_terms.clear();
+	rules.flatten(_expr, _dialect, _ssaValues, 1);
+	rules.m_candidates.clear();
+	rules.m_tree.candidates(rules.m_terms, rules.m_candidates);
+	for (size_t index: rules.m_candidates)
 	{
+		auto const& rule = rules.m_rules[index];
 		rules.resetMatchGroups();
 		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
 			if (!rule.feasible || rule.feasible())
@@ -61,7 +66,7 @@ SimplificationRule<yul::Pattern> const* SimplificationRules::findFirstMatch(
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(dev::eth::Instruction::ADD)].empty();
+	return !m_rules.empty();
 }
 
 std::optional<std::pair<dev::eth::Instruction, vector<Expression> const*>>
@@ -86,7 +91,51 @@ void SimplificationRules::addRules(vector<SimplificationRule<Pattern>> const& _r
 
 void SimplificationRules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	vector<optional<RuleTreeLabel>> labels;
+	m_depth = max(m_depth, _rule.pattern.appendTreeLabels(labels));
+	m_tree.insert(labels, m_rules.size());
+	m_rules.push_back(_rule);
+}
+
+void SimplificationRules::flatten(
+	Expression const& _expr,
+	Dialect const& _dialect,
+	map<YulString, Expression const*> const& _ssaValues,
+	unsigned _depth
+)
+{
+	// Patterns other than "Any" are matched against the values of variables,
+	// see Pattern::matches.
+	Expression const* expr = &_expr;
+	if (holds_alternative<Identifier>(_expr))
+	{
+		auto it = _ssaValues.find(std::get<Identifier>(_expr).name);
+		if (it != _ssaValues.end() && it->second)
+			expr = it->second;
+	}
+
+	size_t index = m_terms.size();
+	m_terms.emplace_back();
+	// Only matched by "Any" unless it is a number or an instruction.
+	m_terms[index].kind = unsigned(PatternKind::Any);
+	if (holds_alternative<Literal>(*expr))
+	{
+		Literal const& literal = std::get<Literal>(*expr);
+		if (literal.kind == LiteralKind::Number)
+		{
+			m_terms[index].kind = unsigned(PatternKind::Constant);
+			m_terms[index].value = valueOfNumberLiteral(literal);
+		}
+	}
+	else if (auto instruction = instructionAndArguments(_dialect, *expr))
+	{
+		m_terms[index].kind = unsigned(PatternKind::Operation);
+		m_terms[index].value = unsigned(instruction->first);
+		if (_depth < m_depth)
+			for (Expression const& argument: *instruction->second)
+				flatten(argument, _dialect, _ssaValues, _depth + 1);
+	}
+	m_terms[index].end = m_terms.size();
 }
 
 SimplificationRules::SimplificationRules()
@@ -120,8 +169,9 @@ yul::Pattern::Pattern(dev::eth::Instruction _instruction, initializer_list<Patte
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, SimplificationRules::MatchGroups& _matchGroups)
 {
+	assertThrow(_group > 0 && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -184,7 +234,7 @@ bool Pattern::matches(
 		// on the variables and not their values.
 		// The assumption is that CSE or local value numbering has been done prior to this step.
 
-		if (m_matchGroups->count(m_matchGroup))
+		if ((*m_matchGroups)[m_matchGroup])
 		{
 			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
 			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
@@ -205,6 +255,21 @@ bool Pattern::matches(
 	return true;
 }
 
+unsigned Pattern::appendTreeLabels(vector<optional<RuleTreeLabel>>& _labels) const
+{
+	assertThrow(m_kind == PatternKind::Operation || m_arguments.empty(), OptimizerException, "Arguments for non-operation.");
+	if (m_kind == PatternKind::Any)
+		_labels.emplace_back(nullopt);
+	else if (m_kind == PatternKind::Constant)
+		_labels.emplace_back(RuleTreeLabel{unsigned(m_kind), m_data ? optional<u256>(*m_data) : nullopt, false});
+	else
+		_labels.emplace_back(RuleTreeLabel{unsigned(m_kind), unsigned(m_instruction), !m_arguments.empty()});
+	unsigned depth = 0;
+	for (Pattern const& argument: m_arguments)
+		depth = max(depth, argument.appendTreeLabels(_labels));
+	return depth + 1;
+}
+
 dev::eth::Instruction Pattern::instruction() const
 {
 	assertThrow(m_kind == PatternKind::Operation, OptimizerException, "");
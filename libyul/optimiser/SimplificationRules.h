@@ -20,6 +20,7 @@
 
 #pragma once
 
+#include <libevmasm/RuleTree.h>
 #include <libevmasm/SimplificationRule.h>
 
 #include <libyul/AsmDataForward.h>
@@ -29,6 +30,7 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -40,10 +42,15 @@ class Pattern;
 
 /**
  * Container for all simplification rules.
+ * The rules are compiled into a RuleTree, so that only the rules that can match
+ * an expression are tried.
  */
 class SimplificationRules: public boost::noncopyable
 {
 public:
+	/// Expressions matched by the match groups of a rule, indexed by the group (starting at 1).
+	using MatchGroups = std::array<Expression const*, 8>;
+
 	SimplificationRules();
 
 	/// @returns a pointer to the first matching pattern and sets the match
@@ -65,11 +72,26 @@ public:
 private:
 	void addRules(std::vector<dev::eth::SimplificationRule<Pattern>> const& _rules);
 	void addRule(dev::eth::SimplificationRule<Pattern> const& _rule);
+	/// Appends @a _expr at depth @a _depth and its arguments up to the depth of the
+	/// deepest pattern to m_terms in pre-order.
+	void flatten(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		std::map<YulString, Expression const*> const& _ssaValues,
+		unsigned _depth
+	);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
-
-	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<dev::eth::SimplificationRule<Pattern>> m_rules[256];
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
+
+	MatchGroups m_matchGroups{};
+	/// The rules in the order they are tried.
+	std::vector<dev::eth::SimplificationRule<Pattern>> m_rules;
+	dev::eth::RuleTree m_tree;
+	/// Depth of the deepest pattern.
+	unsigned m_depth = 0;
+	/// Buffers reused by findFirstMatch.
+	std::vector<dev::eth::RuleTree::Term> m_terms;
+	std::vector<size_t> m_candidates;
 };
 
 enum class PatternKind
@@ -104,13 +126,16 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, SimplificationRules::MatchGroups& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
 		std::map<YulString, Expression const*> const& _ssaValues
 	) const;
+	/// Appends the labels of this pattern and its arguments in pre-order to @a _labels.
+	/// @returns the depth of the pattern.
+	unsigned appendTreeLabels(std::vector<std::optional<dev::eth::RuleTreeLabel>>& _labels) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
 
@@ -131,7 +156,7 @@ private:
 	std::shared_ptr<dev::u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	SimplificationRules::MatchGroups* m_matchGroups = nullptr;
 };
 
 }
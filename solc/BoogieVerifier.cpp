@@ -0,0 +1,724 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Parallel driver that verifies the procedures of a Boogie program.
+ */
+#include <solc/BoogieVerifier.h>
+
+#include <libsolidity/boogie/BoogieSlicer.h>
+#include <libsolidity/boogie/BoogieSmtChecker.h>
+
+#include <libdevcore/CommonIO.h>
+#include <libdevcore/JSON.h>
+#include <libdevcore/Keccak256.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+	#include <io.h>
+	#define popen _popen
+	#define pclose _pclose
+#else
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <signal.h>
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace dev;
+using namespace dev::solidity;
+
+namespace bg = boogie;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// Stands for the name of the slice in cached results.
+string const g_slicePlaceholder = "@SLICE@";
+
+/// Time the previous winner on a procedure runs alone before the rest of the portfolio starts.
+chrono::milliseconds const g_portfolioHeadStart(1000);
+
+struct ProcessOutput
+{
+	bool started = false;
+	bool timedOut = false;
+	bool cancelled = false;
+	/// The process ran, but its exit status could not be obtained.
+	bool failed = false;
+	int exitCode = -1;
+	string output;
+};
+
+#ifdef _WIN32
+
+ProcessOutput runProcess(vector<string> const& _command, unsigned, atomic<bool> const*)
+{
+	ProcessOutput result;
+	string commandLine;
+	for (auto const& arg: _command)
+		commandLine += (arg.find(' ') != string::npos ? "\"" + arg + "\"" : arg) + " ";
+	commandLine += "2>&1";
+
+	FILE* pipe = popen(commandLine.c_str(), "r");
+	if (!pipe)
+		return result;
+	result.started = true;
+	char buffer[4096];
+	while (size_t n = fread(buffer, 1, sizeof(buffer), pipe))
+		result.output.append(buffer, n);
+	result.exitCode = pclose(pipe);
+	return result;
+}
+
+#else
+
+/// Creating the pipe and forking must not interleave between threads, otherwise
+/// children could inherit (and keep open) the pipes of each other.
+mutex g_forkMutex;
+
+ProcessOutput runProcess(vector<string> const& _command, unsigned _timeout, atomic<bool> const* _cancel)
+{
+	ProcessOutput result;
+
+	vector<char*> argv;
+	for (auto const& arg: _command)
+		argv.push_back(const_cast<char*>(arg.c_str()));
+	argv.push_back(nullptr);
+
+	int fds[2];
+	pid_t pid;
+	{
+		lock_guard<mutex> lock(g_forkMutex);
+		if (pipe(fds) != 0)
+			return result;
+		fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+		fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+		pid = fork();
+		if (pid == 0)
+		{
+			// Child: start a process group, so that killing it also stops the solvers Boogie runs,
+			// and redirect both outputs to the pipe (dup2 clears FD_CLOEXEC)
+			setpgid(0, 0);
+			dup2(fds[1], STDOUT_FILENO);
+			dup2(fds[1], STDERR_FILENO);
+			execvp(argv[0], argv.data());
+			_exit(127);
+		}
+	}
+	close(fds[1]);
+	if (pid < 0)
+	{
+		close(fds[0]);
+		return result;
+	}
+	// Also set in the parent, so that the group exists before the first kill.
+	setpgid(pid, pid);
+	result.started = true;
+
+	auto start = chrono::steady_clock::now();
+	char buffer[4096];
+	while (true)
+	{
+		// Checked on every iteration, a process that keeps writing must time out as well.
+		if (_timeout > 0 && chrono::steady_clock::now() - start >= chrono::seconds(_timeout))
+		{
+			kill(-pid, SIGKILL);
+			result.timedOut = true;
+			break;
+		}
+		if (_cancel && *_cancel)
+		{
+			kill(-pid, SIGKILL);
+			result.cancelled = true;
+			break;
+		}
+		pollfd pfd{fds[0], POLLIN, 0};
+		int ready = poll(&pfd, 1, 100);
+		if (ready > 0)
+		{
+			ssize_t n = read(fds[0], buffer, sizeof(buffer));
+			if (n > 0)
+				result.output.append(buffer, size_t(n));
+			else if (n == 0 || errno != EINTR)
+				break;
+		}
+		else if (ready < 0 && errno != EINTR)
+			break;
+	}
+	close(fds[0]);
+
+	int status = 0;
+	pid_t waited;
+	do
+		waited = waitpid(pid, &status, 0);
+	while (waited == -1 && errno == EINTR);
+	if (waited == -1)
+	{
+		result.output += "\nFailed to wait for the process: " + string(strerror(errno)) + "\n";
+		result.failed = true;
+	}
+	else
+		result.exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+	return result;
+}
+
+#endif
+
+/// @returns the path of executable @a _name in PATH or an empty string if not found.
+string findInPath(string const& _name)
+{
+	char const* path = getenv("PATH");
+	if (!path)
+		return "";
+#ifdef _WIN32
+	char const* separator = ";";
+#else
+	char const* separator = ":";
+#endif
+	string paths(path);
+	vector<string> dirs;
+	boost::split(dirs, paths, boost::is_any_of(separator));
+	for (auto const& dir: dirs)
+	{
+		fs::path candidate = fs::path(dir) / _name;
+		boost::system::error_code ec;
+		if (fs::is_regular_file(candidate, ec))
+#ifndef _WIN32
+			if (access(candidate.string().c_str(), X_OK) == 0)
+#endif
+				return candidate.string();
+	}
+	return "";
+}
+
+/// @returns a version of @a _name that can be used in a file name.
+string fileNameFriendly(string const& _name)
+{
+	string result = _name;
+	for (char& c: result)
+		if (!isalnum(c) && c != '_' && c != '-')
+			c = '_';
+	return result;
+}
+
+/// Classifies the output of a Boogie run on a single procedure.
+BoogieVerifier::Status classify(string const& _output)
+{
+	static regex const finished("Boogie program verifier finished with \\d+ verified, (\\d+) errors?");
+	smatch match;
+	if (!regex_search(_output, match, finished))
+		return BoogieVerifier::Status::Failure;
+	// Boogie also reports errors when the solver crashed or did not understand its input
+	static regex const proverFailure("prover error|unexpected prover output|proverexception", regex::icase);
+	if (regex_search(_output, proverFailure))
+		return BoogieVerifier::Status::Failure;
+	if (_output.find("timed out") != string::npos || _output.find(" time out") != string::npos)
+		return BoogieVerifier::Status::Timeout;
+	if (_output.find("inconclusive") != string::npos || _output.find("out of memory") != string::npos)
+		return BoogieVerifier::Status::Inconclusive;
+	return match[1] == "0" ? BoogieVerifier::Status::Verified : BoogieVerifier::Status::Errors;
+}
+
+}
+
+string BoogieVerifier::checkSettings()
+{
+	if (m_settings.solver != "z3" && m_settings.solver != "cvc4")
+		return "Unsupported solver: " + m_settings.solver;
+	if (m_settings.backend != "boogie" && m_settings.backend != "smt")
+		return "Unsupported backend: " + m_settings.backend;
+	if (m_settings.backend == "smt" && !bg::SmtChecker::available(m_settings.solver))
+		return "The SMT backend is not available for " + m_settings.solver + " (not linked into the compiler)";
+
+	m_solvers = {m_settings.solver};
+	for (auto const& solver: m_settings.portfolio)
+	{
+		if (solver != "z3" && solver != "cvc4")
+			return "Unsupported solver: " + solver;
+		if (find(m_solvers.begin(), m_solvers.end(), solver) == m_solvers.end())
+			m_solvers.push_back(solver);
+	}
+	for (auto const& solver: m_solvers)
+	{
+		bool main = solver == m_settings.solver;
+		string path = main && !m_settings.solverBin.empty() ? m_settings.solverBin : findInPath(solver);
+		// The SMT backend only needs the solver binary when falling back to Boogie
+		if (path.empty() && (!main || m_settings.backend == "boogie"))
+			return "Cannot find " + solver;
+		m_solverPaths[solver] = path;
+	}
+	if (m_settings.outputDir.empty())
+		return "No output directory given for the Boogie programs";
+	loadPortfolioStats();
+	return "";
+}
+
+vector<bg::ProcDeclRef> BoogieVerifier::targets(bg::Program& _program)
+{
+	// Procedures with an implementation and annotations (e.g., source location) are
+	// the ones that correspond to Solidity functions, modifiers, etc. Boogie does not
+	// verify inlined procedures on their own, only as part of their callers.
+	vector<bg::ProcDeclRef> procs;
+	for (auto const& decl: _program.getDeclarations())
+		if (decl->getKind() == bg::Decl::PROCEDURE)
+		{
+			auto proc = dynamic_pointer_cast<bg::ProcDecl>(decl);
+			if (proc->hasBody() && !proc->getAttrs().empty() && !proc->hasAttr("inline"))
+				procs.push_back(proc);
+		}
+	return procs;
+}
+
+vector<BoogieVerifier::Result> BoogieVerifier::verify(bg::Program& _program, ResultCallback const& _onResult)
+{
+	vector<bg::ProcDeclRef> procs = targets(_program);
+	vector<Result> results(procs.size());
+	if (procs.empty())
+		return results;
+
+	size_t jobs = m_settings.jobs > 0 ? m_settings.jobs : max(1u, thread::hardware_concurrency());
+	// The solvers of a portfolio race within the same limit, so that at most as many
+	// processes run as procedures would be verified in parallel without a portfolio
+	m_freeProcessSlots = jobs;
+	jobs = min(jobs, procs.size());
+
+	bg::ProgramSlicer slicer(_program);
+	atomic<size_t> next{0};
+	mutex callbackMutex;
+	auto worker = [&]()
+	{
+		for (size_t i = next++; i < procs.size(); i = next++)
+		{
+			results[i] = verifyProcedure(slicer, procs[i], i);
+			lock_guard<mutex> lock(callbackMutex);
+			if (_onResult)
+				_onResult(results[i]);
+		}
+	};
+
+	vector<thread> workers;
+	for (size_t i = 1; i < jobs; ++i)
+		workers.emplace_back(worker);
+	worker();
+	for (auto& w: workers)
+		w.join();
+
+	savePortfolioStats();
+	return results;
+}
+
+BoogieVerifier::Result BoogieVerifier::verifyProcedure(
+	bg::ProgramSlicer const& _slicer,
+	bg::ProcDeclRef const& _proc,
+	size_t _index
+) const
+{
+	auto start = chrono::steady_clock::now();
+
+	string file = (
+		fs::path(m_settings.outputDir) /
+		(m_settings.programName + "." + toString(_index) + "." + fileNameFriendly(_proc->getName()) + ".bpl")
+	).string();
+	// The text of the slice is only kept in memory if it is needed for the cache key
+	bg::Program slice = _slicer.slice(_proc);
+	string sliceText;
+	{
+		ofstream out(file);
+		if (m_settings.cacheDir.empty())
+			slice.print(out);
+		else
+		{
+			stringstream text;
+			slice.print(text);
+			sliceText = text.str();
+			out << sliceText;
+		}
+		if (!out)
+		{
+			Result result;
+			result.procedure = _proc->getName();
+			result.output = "Verifying " + result.procedure + " ...\nerror\n";
+			result.details = "Could not write to file: " + file;
+			return result;
+		}
+	}
+
+	Result result;
+	string key;
+	if (!m_settings.cacheDir.empty())
+	{
+		key = cacheKey(sliceText);
+		if (lookupCache(key, file, result))
+		{
+			result.time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			return result;
+		}
+	}
+
+	if (m_settings.backend != "smt" || !checkSmt(slice, _proc, result))
+		result = m_solvers.size() > 1 ?
+			racePortfolio(file, _proc->getName()) :
+			runBoogie(file, _proc->getName(), m_settings.solver);
+	result.time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	if (!key.empty() && result.status != Status::Failure)
+		storeCache(key, file, result);
+	return result;
+}
+
+bool BoogieVerifier::checkSmt(bg::Program& _slice, bg::ProcDeclRef const& _proc, Result& _result) const
+{
+	auto start = chrono::steady_clock::now();
+	bg::SmtChecker::Result smtResult = bg::SmtChecker(m_settings.solver, m_settings.timeout).check(_slice, _proc);
+	double time = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	_result = Result();
+	_result.procedure = _proc->getName();
+	string header = "Verifying " + _result.procedure + " ...\n";
+	string summary = "  [" + toString(time) + " s, " + toString(smtResult.obligations) + " proof obligations]  ";
+	switch (smtResult.outcome)
+	{
+	case bg::SmtChecker::Outcome::Verified:
+		_result.status = Status::Verified;
+		_result.output = header + summary + "verified\n\nBoogie program verifier finished with 1 verified, 0 errors\n";
+		return true;
+	case bg::SmtChecker::Outcome::Timeout:
+		_result.status = Status::Timeout;
+		_result.output = header + "timeout\n";
+		return true;
+	default:
+		// Errors are confirmed by Boogie, which also reports them with their locations
+		return false;
+	}
+}
+
+BoogieVerifier::Result BoogieVerifier::runBoogie(
+	string const& _file,
+	string const& _proc,
+	string const& _solver,
+	atomic<bool> const* _cancel
+) const
+{
+	Result result;
+	result.procedure = _proc;
+	result.solver = _solver;
+
+	vector<string> command = boogieCommand(_file, _proc, _solver);
+	ProcessOutput process;
+	if (acquireProcessSlot(_cancel))
+	{
+		process = runProcess(command, m_settings.timeout, _cancel);
+		releaseProcessSlot();
+	}
+	else
+		process.cancelled = true;
+
+	if (process.cancelled)
+	{
+		result.output = "Verifying " + result.procedure + " ...\nerror\n";
+		result.details = "Cancelled";
+		return result;
+	}
+	if (process.timedOut)
+	{
+		result.status = Status::Timeout;
+		result.output = "Verifying " + result.procedure + " ...\ntimeout\n";
+		return result;
+	}
+	if (!process.started || process.failed || process.exitCode == 127)
+	{
+		result.output = "Verifying " + result.procedure + " ...\nerror\n";
+		result.details = "Could not run verifier: " + boost::join(command, " ") + "\n" + process.output;
+		return result;
+	}
+
+	result.status = classify(process.output);
+	if (result.status == Status::Failure)
+	{
+		result.output = "Verifying " + result.procedure + " ...\nerror\n";
+		result.details = process.output;
+	}
+	else
+		result.output = process.output;
+	return result;
+}
+
+BoogieVerifier::Result BoogieVerifier::racePortfolio(string const& _file, string const& _proc) const
+{
+	// Solvers that won on this procedure before are started first
+	vector<string> solvers = m_solvers;
+	bool headStart = false;
+	{
+		lock_guard<mutex> lock(m_winsMutex);
+		auto it = m_wins.find(_proc);
+		if (it != m_wins.end())
+		{
+			auto wins = [&](string const& _solver) { return it->second.count(_solver) ? it->second.at(_solver) : 0; };
+			stable_sort(solvers.begin(), solvers.end(), [&](string const& _a, string const& _b) { return wins(_a) > wins(_b); });
+			headStart = wins(solvers.front()) > 0;
+		}
+	}
+
+	atomic<bool> cancel{false};
+	mutex resultMutex;
+	condition_variable finished;
+	vector<Result> results(solvers.size());
+	size_t done = 0;
+	boost::optional<size_t> winner;
+	auto run = [&](size_t _index)
+	{
+		Result result = runBoogie(_file, _proc, solvers[_index], &cancel);
+		lock_guard<mutex> lock(resultMutex);
+		results[_index] = move(result);
+		++done;
+		// Only a proof ends the race. Errors are also reported when a solver gives up,
+		// another solver of the portfolio can still verify the procedure.
+		if (results[_index].status == Status::Verified && !winner)
+		{
+			winner = _index;
+			cancel = true;
+		}
+		finished.notify_all();
+	};
+
+	vector<thread> runners;
+	runners.emplace_back(run, 0);
+	if (headStart)
+	{
+		unique_lock<mutex> lock(resultMutex);
+		finished.wait_for(lock, g_portfolioHeadStart, [&]() { return done > 0; });
+	}
+	if (!cancel)
+		for (size_t i = 1; i < solvers.size(); ++i)
+			runners.emplace_back(run, i);
+	for (auto& runner: runners)
+		runner.join();
+
+	if (!winner)
+		for (size_t i = 0; i < results.size(); ++i)
+			if (results[i].status == Status::Errors)
+			{
+				winner = i;
+				break;
+			}
+	if (winner)
+	{
+		lock_guard<mutex> lock(m_winsMutex);
+		m_wins[_proc][solvers[*winner]]++;
+		return results[*winner];
+	}
+	// Without an answer, a timeout or inconclusive result is more informative than a failure
+	for (auto const& result: results)
+		if (result.status != Status::Failure)
+			return result;
+	return results.front();
+}
+
+string BoogieVerifier::cacheKey(string const& _slice) const
+{
+	// The result depends on the program and on the settings of the verifier, including
+	// the backend and all solvers of the portfolio (the answers differ in timeouts)
+	return keccak256(
+		m_settings.backend + "\n" +
+		boost::join(m_solvers, ",") + "\n" +
+		m_settings.arithmetic + "\n" +
+		toString(m_settings.timeout) + "\n" +
+		_slice
+	).hex();
+}
+
+bool BoogieVerifier::lookupCache(string const& _key, string const& _file, Result& _result) const
+{
+	fs::path entry = fs::path(m_settings.cacheDir) / (_key + ".json");
+	boost::system::error_code ec;
+	if (!fs::is_regular_file(entry, ec))
+		return false;
+
+	Json::Value json;
+	if (!jsonParseStrict(readFileAsString(entry.string()), json) || !json.isObject())
+		return false;
+	auto status = statusFromString(json["status"].asString());
+	if (!status || !json["output"].isString())
+		return false;
+
+	_result.procedure = json["procedure"].asString();
+	_result.status = *status;
+	_result.output = boost::replace_all_copy(json["output"].asString(), g_slicePlaceholder, _file);
+	_result.cached = true;
+	return true;
+}
+
+void BoogieVerifier::storeCache(string const& _key, string const& _file, Result const& _result) const
+{
+	Json::Value json(Json::objectValue);
+	json["procedure"] = _result.procedure;
+	json["status"] = statusToString(_result.status);
+	// Error messages refer to the slice, which can have a different name next time
+	json["output"] = boost::replace_all_copy(_result.output, _file, g_slicePlaceholder);
+	json["backend"] = m_settings.backend;
+	json["solvers"] = boost::join(m_solvers, ",");
+	json["arithmetic"] = m_settings.arithmetic;
+	json["timeout"] = m_settings.timeout;
+	json["time"] = _result.time;
+
+	// Write to a temporary file first so that concurrent runs never see partial entries
+	boost::system::error_code ec;
+	fs::create_directories(m_settings.cacheDir, ec);
+	fs::path entry = fs::path(m_settings.cacheDir) / (_key + ".json");
+	fs::path tmp = fs::path(m_settings.cacheDir) / fs::unique_path(_key + ".%%%%-%%%%.tmp");
+	{
+		ofstream out(tmp.string());
+		out << jsonCompactPrint(json);
+		if (!out)
+			return;
+	}
+	fs::rename(tmp, entry, ec);
+	if (ec)
+		fs::remove(tmp, ec);
+}
+
+string BoogieVerifier::statusToString(Status _status)
+{
+	switch (_status)
+	{
+	case Status::Verified: return "verified";
+	case Status::Errors: return "errors";
+	case Status::Timeout: return "timeout";
+	case Status::Inconclusive: return "inconclusive";
+	case Status::Failure: return "failure";
+	}
+	return "failure";
+}
+
+boost::optional<BoogieVerifier::Status> BoogieVerifier::statusFromString(string const& _status)
+{
+	for (auto status: {Status::Verified, Status::Errors, Status::Timeout, Status::Inconclusive, Status::Failure})
+		if (statusToString(status) == _status)
+			return status;
+	return {};
+}
+
+vector<string> BoogieVerifier::boogieCommand(string const& _file, string const& _proc, string const& _solver) const
+{
+	vector<string> command;
+	boost::split(command, m_settings.boogie, boost::is_any_of(" "), boost::token_compress_on);
+	command.push_back(_file);
+	command.push_back("/proc:" + _proc);
+	for (string arg: {"/nologo", "/doModSetAnalysis", "/errorTrace:0", "/useArrayTheory", "/trace", "/infer:j"})
+		command.push_back(arg);
+	if (!m_settings.smtLog.empty())
+		command.push_back("/proverLog:" + m_settings.smtLog);
+	command.push_back("/proverOpt:PROVER_PATH=" + m_solverPaths.at(_solver));
+	if (_solver == "cvc4")
+	{
+		command.push_back("/proverOpt:SOLVER=CVC4");
+		command.push_back("/proverOpt:C:--produce-models --quiet");
+		if (m_settings.arithmetic == "mod" || m_settings.arithmetic == "mod-overflow")
+		{
+			command.push_back("/proverOpt:C:--incremental --decision=justification --no-arrays-eager-index --arrays-eager-lemmas");
+			command.push_back("/proverOpt:LOGIC=QF_AUFDTNIA");
+		}
+	}
+	return command;
+}
+
+void BoogieVerifier::loadPortfolioStats()
+{
+	if (m_settings.portfolioStats.empty())
+		return;
+	boost::system::error_code ec;
+	if (!fs::is_regular_file(m_settings.portfolioStats, ec))
+		return;
+	Json::Value json;
+	if (!jsonParseStrict(readFileAsString(m_settings.portfolioStats), json) || !json.isObject())
+		return;
+	lock_guard<mutex> lock(m_winsMutex);
+	for (auto const& proc: json.getMemberNames())
+		if (json[proc].isObject())
+			for (auto const& solver: json[proc].getMemberNames())
+				if (json[proc][solver].isUInt())
+					m_wins[proc][solver] = json[proc][solver].asUInt();
+}
+
+void BoogieVerifier::savePortfolioStats() const
+{
+	if (m_settings.portfolioStats.empty())
+		return;
+	Json::Value json(Json::objectValue);
+	{
+		lock_guard<mutex> lock(m_winsMutex);
+		for (auto const& proc: m_wins)
+			for (auto const& solver: proc.second)
+				json[proc.first][solver.first] = solver.second;
+	}
+
+	// Write to a temporary file first so that concurrent runs never see a partial file
+	boost::system::error_code ec;
+	fs::path stats(m_settings.portfolioStats);
+	fs::path tmp = stats.parent_path() / fs::unique_path(stats.filename().string() + ".%%%%-%%%%.tmp");
+	{
+		ofstream out(tmp.string());
+		out << jsonPrettyPrint(json) << endl;
+		if (!out)
+		{
+			out.close();
+			fs::remove(tmp, ec);
+			return;
+		}
+	}
+	fs::rename(tmp, stats, ec);
+	if (ec)
+		fs::remove(tmp, ec);
+}
+
+bool BoogieVerifier::acquireProcessSlot(atomic<bool> const* _cancel) const
+{
+	unique_lock<mutex> lock(m_processSlotsMutex);
+	while (m_freeProcessSlots == 0)
+	{
+		if (_cancel && *_cancel)
+			return false;
+		m_processSlotFreed.wait_for(lock, chrono::milliseconds(100));
+	}
+	--m_freeProcessSlots;
+	return true;
+}
+
+void BoogieVerifier::releaseProcessSlot() const
+{
+	{
+		lock_guard<mutex> lock(m_processSlotsMutex);
+		++m_freeProcessSlots;
+	}
+	m_processSlotFreed.notify_one();
+}
@@ -0,0 +1,187 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Parallel driver that verifies the procedures of a Boogie program.
+ */
+#pragma once
+
+#include <libsolidity/boogie/BoogieAst.h>
+#include <libsolidity/boogie/BoogieAstDecl.h>
+
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace boogie
+{
+class ProgramSlicer;
+}
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Verifies the procedures of a Boogie program in-process instead of running
+ * Boogie once per procedure on the whole program. Each procedure is written to
+ * its own program slice (containing only the declarations it depends on) and
+ * checked by a separate Boogie process (or by the SMT backend). The slices
+ * are scheduled on a work queue processed by a pool of threads and the results
+ * are reported as soon as they are available.
+ */
+class BoogieVerifier
+{
+public:
+	struct Settings
+	{
+		/// Boogie command, can contain arguments (e.g., "dotnet BoogieDriver.dll").
+		std::string boogie = "boogie";
+		/// Name of the SMT solver used by Boogie (z3 or cvc4).
+		std::string solver = "z3";
+		/// Path to the solver binary, looked up in PATH if empty.
+		std::string solverBin;
+		/// Arithmetic encoding of the program (int, bv, mod, mod-overflow).
+		std::string arithmetic = "int";
+		/// Time limit for a single procedure in seconds, 0 means no limit.
+		unsigned timeout = 10;
+		/// Number of procedures verified in parallel, 0 means number of cores.
+		unsigned jobs = 0;
+		/// File where the input of the solver is logged (Boogie replaces @PROC@ with the procedure).
+		std::string smtLog;
+		/// Directory where the program slices are written.
+		std::string outputDir;
+		/// Base name of the program slices.
+		std::string programName = "program";
+		/// Directory of the result cache (keyed by the hash of the slices), disabled if empty.
+		std::string cacheDir;
+		/// Backend checking the slices: "boogie", or "smt" for generating the verification
+		/// conditions directly and checking them with the solver linked into the compiler
+		/// (procedures it cannot prove are verified by Boogie).
+		std::string backend = "boogie";
+		/// Further solvers raced against the solver on each procedure, the first proof is
+		/// taken and the other runs are killed. Errors are only reported if no solver verifies
+		/// the procedure. Portfolio runs share the process limit given by the jobs.
+		std::vector<std::string> portfolio;
+		/// File recording which solver won the race on each procedure, the winner is
+		/// given a head start next time. Disabled if empty.
+		std::string portfolioStats;
+	};
+
+	enum class Status
+	{
+		Verified,     ///< All proof obligations verified
+		Errors,       ///< Some proof obligations could not be verified
+		Timeout,      ///< The verifier ran out of time
+		Inconclusive, ///< The solver could not give a definite answer
+		Failure       ///< Boogie could not be run or failed with an error
+	};
+
+	struct Result
+	{
+		/// Name of the Boogie procedure.
+		std::string procedure;
+		Status status = Status::Failure;
+		/// Output in the format of Boogie (/trace), used to map errors back to the source.
+		std::string output;
+		/// Additional details on failures (e.g., the raw output of Boogie).
+		std::string details;
+		/// Wall time of the verification in seconds.
+		double time = 0;
+		/// Whether the result was taken from the cache.
+		bool cached = false;
+		/// Solver that gave the result (the winner of the race in portfolio mode).
+		std::string solver;
+	};
+
+	using ResultCallback = std::function<void(Result const&)>;
+
+	explicit BoogieVerifier(Settings _settings): m_settings(std::move(_settings)) {}
+
+	/// Looks up the solver binaries and reads the portfolio statistics.
+	/// @returns an empty string on success or an error message otherwise.
+	std::string checkSettings();
+
+	/// Verifies all procedures of @a _program that have an implementation. The callback
+	/// is called (from one thread at a time) whenever a procedure is finished.
+	/// @returns the results in the order the procedures appear in the program.
+	std::vector<Result> verify(boogie::Program& _program, ResultCallback const& _onResult);
+
+	/// @returns the procedures of @a _program that are verification targets.
+	static std::vector<boogie::ProcDeclRef> targets(boogie::Program& _program);
+
+	static std::string statusToString(Status _status);
+	static boost::optional<Status> statusFromString(std::string const& _status);
+
+private:
+	/// Writes the slice for @a _proc and runs Boogie on it (unless the result is cached).
+	Result verifyProcedure(boogie::ProgramSlicer const& _slicer, boogie::ProcDeclRef const& _proc, size_t _index) const;
+	/// Runs Boogie with @a _solver on procedure @a _proc in @a _file. The run is killed
+	/// (and reported as a failure) when @a _cancel is set.
+	Result runBoogie(
+		std::string const& _file,
+		std::string const& _proc,
+		std::string const& _solver,
+		std::atomic<bool> const* _cancel = nullptr
+	) const;
+	/// Races the solvers of the portfolio on procedure @a _proc in @a _file.
+	Result racePortfolio(std::string const& _file, std::string const& _proc) const;
+	/// Checks procedure @a _proc in @a _slice with the SMT backend.
+	/// @returns false if the backend could not prove the procedure (or run out of time)
+	/// and Boogie should be used instead.
+	bool checkSmt(boogie::Program& _slice, boogie::ProcDeclRef const& _proc, Result& _result) const;
+
+	/// @returns the key of a slice in the result cache.
+	std::string cacheKey(std::string const& _slice) const;
+	/// Looks up the result for @a _key in the cache, @a _file is the current slice.
+	/// @returns true if found.
+	bool lookupCache(std::string const& _key, std::string const& _file, Result& _result) const;
+	/// Stores the result for @a _key in the cache, @a _file is the current slice.
+	void storeCache(std::string const& _key, std::string const& _file, Result const& _result) const;
+
+	/// @returns the command line for verifying procedure @a _proc in @a _file with @a _solver.
+	std::vector<std::string> boogieCommand(std::string const& _file, std::string const& _proc, std::string const& _solver) const;
+
+	/// Waits until fewer Boogie processes run than allowed by the jobs setting.
+	/// @returns false if @a _cancel was set while waiting.
+	bool acquireProcessSlot(std::atomic<bool> const* _cancel) const;
+	void releaseProcessSlot() const;
+
+	void loadPortfolioStats();
+	void savePortfolioStats() const;
+
+	Settings m_settings;
+	/// The solver followed by the rest of the portfolio.
+	std::vector<std::string> m_solvers;
+	std::map<std::string, std::string> m_solverPaths;
+	/// Number of races won by each solver, per procedure.
+	mutable std::map<std::string, std::map<std::string, unsigned>> m_wins;
+	mutable std::mutex m_winsMutex;
+	/// Number of further Boogie processes that can be started.
+	mutable size_t m_freeProcessSlots = 0;
+	mutable std::mutex m_processSlotsMutex;
+	mutable std::condition_variable m_processSlotFreed;
+};
+
+}
+}
@@ -21,6 +21,8 @@
  * Solidity command line interface.
  */
 #include <solc/CommandLineInterface.h>
+#include <solc/BoogieVerifier.h>
+#include <solc/Profiler.h>
 
 #include "solidity/BuildInfo.h"
 #include "license.h"
@@ -32,6 +34,7 @@
 #include <libsolidity/boogie/ASTBoogieConverter.h>
 #include <libsolidity/boogie/ASTBoogieStats.h>
 #include <libsolidity/boogie/BoogieContext.h>
+#include <libsolidity/boogie/BoogieLetBinder.h>
 #include <libsolidity/boogie/EmitsChecker.h>
 #include <libsolidity/analysis/GlobalContext.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
@@ -120,9 +123,23 @@ static string const g_strAstBoogieArithMod = "mod";
 static string const g_strAstBoogieArithModOverflow = "mod-overflow";
 static string const g_strAstBoogieModAnalysis = "boogie-mod-analysis";
 static string const g_strAstBoogieEventAnalysis = "boogie-event-analysis";
+static string const g_strAstBoogieShareExprs = "boogie-share-exprs";
+static string const g_strAstBoogieVerify = "boogie-verify";
+static string const g_strAstBoogieExe = "boogie-exe";
+static string const g_strAstBoogieBackend = "boogie-backend";
+static string const g_strAstBoogieSolver = "boogie-solver";
+static string const g_strAstBoogieSolverBin = "boogie-solver-bin";
+static string const g_strAstBoogiePortfolio = "boogie-portfolio";
+static string const g_strAstBoogiePortfolioStats = "boogie-portfolio-stats";
+static string const g_strAstBoogieTimeout = "boogie-timeout";
+static string const g_strAstBoogieJobs = "boogie-jobs";
+static string const g_strAstBoogieSmtLog = "boogie-smt-log";
+static string const g_strAstBoogieCache = "boogie-cache";
+static string const g_strVerifyProfile = "verify-profile";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
 static string const g_strCombinedJson = "combined-json";
+static string const g_strCompileJobs = "compile-jobs";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
 static string const g_strErrorRecovery = "error-recovery";
@@ -144,6 +161,9 @@ static string const g_strLink = "link";
 static string const g_strMachine = "machine";
 static string const g_strMetadata = "metadata";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerJobs = "model-checker-jobs";
+static string const g_strSMTCache = "smt-cache";
+static string const g_strServer = "server";
 static string const g_strNatspecDev = "devdoc";
 static string const g_strNatspecUser = "userdoc";
 static string const g_strOpcodes = "opcodes";
@@ -183,6 +203,7 @@ static string const g_argAstBoogie = g_strAstBoogie;
 static string const g_argAstBoogieArith = g_strAstBoogieArith;
 static string const g_argAstBoogieModAnalysis = g_strAstBoogieModAnalysis;
 static string const g_argAstBoogieEventAnalysis = g_strAstBoogieEventAnalysis;
+static string const g_argAstBoogieShareExprs = g_strAstBoogieShareExprs;
 static string const g_argErrorRecovery = g_strErrorRecovery;
 static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
@@ -626,6 +647,11 @@ bool CommandLineInterface::parseLibraryOption(string const& _input)
 }
 
 void CommandLineInterface::createFile(string const& _fileName, string const& _data)
+{
+	createFile(_fileName, [&](ostream& _out) { _out << _data; });
+}
+
+void CommandLineInterface::createFile(string const& _fileName, function<void(ostream&)> const& _write)
 {
 	namespace fs = boost::filesystem;
 	// create directory if not existent
@@ -640,8 +666,13 @@ void CommandLineInterface::createFile(string const& _fileName, string const& _da
 		m_error = true;
 		return;
 	}
-	ofstream outFile(pathName);
-	outFile << _data;
+	// Large outputs (e.g., Boogie programs) are written in big chunks
+	vector<char> buffer(1 << 20);
+	ofstream outFile;
+	outFile.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+	outFile.open(pathName);
+	_write(outFile);
+	outFile.close();
 	if (!outFile)
 		BOOST_THROW_EXCEPTION(FileError() << errinfo_comment("Could not write to file: " + pathName));
 }
@@ -693,6 +724,23 @@ Allowed options)",
 			"Lower values will optimize more for initial deployment cost, higher values will optimize more for high-frequency usage."
 		)
 		(g_strOptimizeYul.c_str(), "Enable Yul optimizer in Solidity, mostly for ABIEncoderV2. Still considered experimental.")
+		(
+			g_strCompileJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of contracts compiled in parallel (0 for the number of cores). "
+			"The bytecode does not depend on this setting."
+		)
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("n")->default_value(1),
+			"Number of threads used by the SMTChecker to check the targets of a function "
+			"(0 for the number of cores)."
+		)
+		(
+			g_strSMTCache.c_str(),
+			po::value<string>()->value_name("path"),
+			"Directory where the SMTChecker stores the answers of the SMT solvers and reuses them in later runs."
+		)
 		(g_argPrettyJson.c_str(), "Output JSON in pretty format. Currently it only works with the combined JSON output.")
 		(
 			g_argLibraries.c_str(),
@@ -718,6 +766,12 @@ Allowed options)",
 			"Switch to Standard JSON input / output mode, ignoring all options. "
 			"It reads from standard input and provides the result on the standard output."
 		)
+		(
+			g_strServer.c_str(),
+			"Keep running in Standard JSON mode: read one input per line from standard input and write "
+			"the output for each on one line of standard output. The analysed and compiled state of recent "
+			"inputs is kept and reused for inputs with the same sources and settings."
+		)
 		(
 			g_argAssemble.c_str(),
 			"Switch to assembly mode, ignoring all options except --machine, --yul-dialect and --optimize and assumes input is assembly."
@@ -769,6 +823,79 @@ Allowed options)",
 		)
 		(g_argAstBoogieModAnalysis.c_str(), "Enable modifies analysis in Boogie even if there is no spec.")
 		(g_argAstBoogieEventAnalysis.c_str(), "Enable event analysis in Boogie even if there is no spec.")
+		(
+				g_argAstBoogieShareExprs.c_str(),
+				"Bind repeated subexpressions of Boogie statements to variables (let expressions) "
+				"so that they appear only once in the program and the verification conditions."
+		)
+		(
+				g_strAstBoogieVerify.c_str(),
+				"Verify the procedures of the Boogie program in parallel (requires --boogie). "
+				"Each procedure is sliced to its own program and checked by a separate Boogie process."
+		)
+		(
+				g_strAstBoogieExe.c_str(),
+				po::value<string>()->value_name("command")->default_value("boogie"),
+				"Boogie verifier command used by --boogie-verify."
+		)
+		(
+				g_strAstBoogieBackend.c_str(),
+				po::value<string>()->value_name("boogie,smt")->default_value("boogie"),
+				"Backend used by --boogie-verify. The smt backend generates the verification conditions "
+				"directly and checks them with the solver linked into the compiler, falling back to "
+				"Boogie for procedures it cannot prove."
+		)
+		(
+				g_strAstBoogieSolver.c_str(),
+				po::value<string>()->value_name("z3,cvc4")->default_value("z3"),
+				"SMT solver used by the verifier."
+		)
+		(
+				g_strAstBoogieSolverBin.c_str(),
+				po::value<string>()->value_name("path"),
+				"Binary of the solver to use (looked up in PATH if not given)."
+		)
+		(
+				g_strAstBoogiePortfolio.c_str(),
+				po::value<string>()->value_name("solvers"),
+				"Comma separated list of further solvers (looked up in PATH) that are raced against "
+				"the solver on each procedure. The first proof is taken, errors are reported if no "
+				"solver verifies the procedure."
+		)
+		(
+				g_strAstBoogiePortfolioStats.c_str(),
+				po::value<string>()->value_name("file"),
+				"File recording which solver of the portfolio won on each procedure. The winner "
+				"is started first in later runs."
+		)
+		(
+				g_strAstBoogieTimeout.c_str(),
+				po::value<unsigned>()->value_name("seconds")->default_value(10),
+				"Timeout for verifying a single procedure."
+		)
+		(
+				g_strAstBoogieJobs.c_str(),
+				po::value<unsigned>()->value_name("n")->default_value(0),
+				"Number of procedures verified in parallel (0 uses all cores)."
+		)
+		(
+				g_strAstBoogieSmtLog.c_str(),
+				po::value<string>()->value_name("file"),
+				"Log the input of the SMT solver (@PROC@ is replaced by the procedure name)."
+		)
+		(
+				g_strAstBoogieCache.c_str(),
+				po::value<string>()->value_name("path"),
+				"Directory for caching verification results. Procedures whose Boogie slice "
+				"did not change since a previous run are not verified again."
+		)
+		(
+				g_strVerifyProfile.c_str(),
+				po::value<string>()->value_name("file"),
+				"Write the wall time, memory usage and counts (e.g., AST nodes, contracts and Boogie "
+				"procedures) of the compiler and Boogie conversion phases, and the verification "
+				"time of each procedure to a JSON file."
+		)
 		(g_argAsm.c_str(), "EVM assembly of the contracts.")
 		(g_argAsmJson.c_str(), "EVM assembly of the contracts in JSON format.")
 		(g_argOpcodes.c_str(), "Opcodes of the contracts.")
@@ -810,6 +937,12 @@ Allowed options)",
 		return false;
 	}
 
+	if (m_args.count(g_strServer) && !m_args.count(g_argStandardJSON))
+	{
+		serr() << "Option --" << g_strServer << " can only be used with --" << g_argStandardJSON << "." << endl;
+		return false;
+	}
+
 	m_coloredOutput = !m_args.count(g_argNoColor) && (isatty(STDERR_FILENO) || m_args.count(g_argColor));
 
 	if (m_args.count(g_argHelp) || (isatty(fileno(stdin)) && _argc == 1))
@@ -907,8 +1040,19 @@ bool CommandLineInterface::processInput()
 
 	if (m_args.count(g_argStandardJSON))
 	{
-		string input = dev::readStandardInput();
 		StandardCompiler compiler(fileReader);
+		if (m_args.count(g_strSMTCache))
+			compiler.setSMTQueryCache(m_args[g_strSMTCache].as<string>());
+		if (m_args.count(g_strServer))
+		{
+			compiler.setCompilationCacheSize(4);
+			string input;
+			while (getline(cin, input))
+				if (!input.empty())
+					sout() << compiler.compile(std::move(input)) << endl;
+			return true;
+		}
+		string input = dev::readStandardInput();
 		sout() << compiler.compile(std::move(input)) << endl;
 		return true;
 	}
@@ -1002,6 +1146,8 @@ bool CommandLineInterface::processInput()
 	}
 
 	m_compiler = make_unique<CompilerStack>(fileReader);
+	if (m_args.count(g_strVerifyProfile))
+		m_profiler = make_unique<Profiler>();
 
 	unique_ptr<SourceReferenceFormatter> formatter;
 	if (m_args.count(g_argNewReporter))
@@ -1030,8 +1176,31 @@ bool CommandLineInterface::processInput()
 		settings.runYulOptimiser = m_args.count(g_strOptimizeYul);
 		settings.optimizeStackAllocation = settings.runYulOptimiser;
 		m_compiler->setOptimiserSettings(settings);
+		m_compiler->setCompilationJobs(m_args[g_strCompileJobs].as<unsigned>());
+		m_compiler->setModelCheckerJobs(m_args[g_strModelCheckerJobs].as<unsigned>());
+		if (m_args.count(g_strSMTCache))
+			m_compiler->setSMTQueryCache(m_args[g_strSMTCache].as<string>());
 
-		bool successful = m_compiler->compile();
+		bool successful = false;
+		if (m_profiler)
+		{
+			// The stages are run separately to profile them
+			m_profiler->start("parsing");
+			successful = m_compiler->parse();
+			if (successful)
+				m_profiler->count("astNodes", countASTNodes());
+			m_profiler->start("analysis");
+			if (successful || m_args.count(g_argErrorRecovery))
+				successful = m_compiler->analyze();
+			if (successful)
+				m_profiler->count("contracts", m_compiler->contractNames().size());
+			m_profiler->start("code generation");
+			if (successful)
+				successful = m_compiler->compile();
+			m_profiler->stop();
+		}
+		else
+			successful = m_compiler->compile();
 
 		for (auto const& error: m_compiler->errors())
 		{
@@ -1260,6 +1429,8 @@ void CommandLineInterface::handleBoogie()
 	ErrorList errorList;
 	ErrorReporter errorReporter(errorList);
 
+	if (m_profiler)
+		m_profiler->start("boogie statistics");
 	ASTBoogieStats stats;
 	for (auto const& sourceCode: m_sourceCodes)
 		m_compiler->ast(sourceCode.first).accept(stats);
@@ -1303,6 +1474,8 @@ void CommandLineInterface::handleBoogie()
 
 	SourceReferenceFormatter formatter(serr(false));
 
+	if (m_profiler)
+		m_profiler->start("boogie emits check");
 	for (auto const& sourceCode: m_sourceCodes)
 	{
 		context.currentScanner() = &m_compiler->scanner(sourceCode.first);
@@ -1313,6 +1486,8 @@ void CommandLineInterface::handleBoogie()
 	if (m_args.count(g_strAstBoogieEventAnalysis) || stats.hasEventSpecs())
 		eventsOk = emitsChecker.check();
 
+	if (m_profiler)
+		m_profiler->start("boogie conversion");
 	if (eventsOk)
 	{
 		for (auto const& sourceCode: m_sourceCodes)
@@ -1347,18 +1522,123 @@ void CommandLineInterface::handleBoogie()
 		return;
 	}
 
+	if (m_profiler)
+	{
+		auto const& decls = context.program().getDeclarations();
+		m_profiler->count("boogieDeclarations", decls.size());
+		m_profiler->count("boogieProcedures", count_if(decls.begin(), decls.end(), [](boogie::Decl::Ref const& _decl) {
+			return _decl->getKind() == boogie::Decl::PROCEDURE;
+		}));
+	}
+
+	if (m_args.count(g_argAstBoogieShareExprs))
+	{
+		if (m_profiler)
+			m_profiler->start("boogie let binding");
+		boogie::LetBinder().bind(context.program());
+	}
+
+	if (m_profiler)
+		m_profiler->start("boogie printing");
+
+	// When multiple files are given, output file will have the name of the first file
+	boost::filesystem::path path(m_args[g_argInputFile].as<vector<string>>()[0]);
 	if (m_args.count(g_argOutputDir))
 	{
-		stringstream data;
-		context.print(data);
-		// When multiple files are given, output file will have the name of the first file
-		boost::filesystem::path path(m_args[g_argInputFile].as<vector<string>>()[0]);
-		createFile(path.filename().string() + ".bpl", data.str());
+		createFile(path.filename().string() + ".bpl", [&](ostream& _out) { context.print(_out); });
 	}
 	else
 	{
 		context.print(sout());
 	}
+	if (m_profiler)
+		m_profiler->stop();
+
+	if (m_args.count(g_strAstBoogieVerify))
+		handleBoogieVerification(context.program(), path.filename().string());
+}
+
+void CommandLineInterface::handleBoogieVerification(boogie::Program& _program, string const& _programName)
+{
+	namespace fs = boost::filesystem;
+
+	BoogieVerifier::Settings settings;
+	settings.boogie = m_args[g_strAstBoogieExe].as<string>();
+	settings.backend = m_args[g_strAstBoogieBackend].as<string>();
+	settings.solver = m_args[g_strAstBoogieSolver].as<string>();
+	if (m_args.count(g_strAstBoogieSolverBin))
+		settings.solverBin = m_args[g_strAstBoogieSolverBin].as<string>();
+	if (m_args.count(g_strAstBoogiePortfolio))
+		boost::split(
+			settings.portfolio,
+			m_args[g_strAstBoogiePortfolio].as<string>(),
+			boost::is_any_of(","),
+			boost::token_compress_on
+		);
+	if (m_args.count(g_strAstBoogiePortfolioStats))
+		settings.portfolioStats = m_args[g_strAstBoogiePortfolioStats].as<string>();
+	if (m_args.count(g_argAstBoogieArith))
+		settings.arithmetic = m_args[g_argAstBoogieArith].as<string>();
+	settings.timeout = m_args[g_strAstBoogieTimeout].as<unsigned>();
+	settings.jobs = m_args[g_strAstBoogieJobs].as<unsigned>();
+	if (m_args.count(g_strAstBoogieSmtLog))
+		settings.smtLog = m_args[g_strAstBoogieSmtLog].as<string>();
+	if (m_args.count(g_strAstBoogieCache))
+		settings.cacheDir = m_args[g_strAstBoogieCache].as<string>();
+	settings.programName = _programName;
+
+	// Slices are kept next to the program if there is an output directory (so that
+	// errors can be traced back), otherwise they go to a temporary directory.
+	fs::path tmpDir;
+	if (m_args.count(g_argOutputDir))
+		settings.outputDir = m_args.at(g_argOutputDir).as<string>();
+	else
+	{
+		tmpDir = fs::temp_directory_path() / fs::unique_path("solc-verify-%%%%-%%%%-%%%%");
+		fs::create_directories(tmpDir);
+		settings.outputDir = tmpDir.string();
+	}
+
+	BoogieVerifier verifier(settings);
+	string error = verifier.checkSettings();
+	if (!error.empty())
+	{
+		serr() << "Error: " << error << endl;
+		m_error = true;
+	}
+	else
+	{
+		sout() << endl << "======= Verifying Boogie procedures =======" << endl;
+		if (m_profiler)
+			m_profiler->start("boogie verification");
+		auto results = verifier.verify(_program, [&](BoogieVerifier::Result const& _result) {
+			sout() << _result.output << flush;
+			if (!_result.details.empty())
+				serr() << _result.details << endl;
+		});
+		if (m_profiler)
+		{
+			m_profiler->count("procedures", results.size());
+			m_profiler->stop();
+			for (auto const& result: results)
+			{
+				Json::Value procedure(Json::objectValue);
+				procedure["name"] = result.procedure;
+				procedure["status"] = BoogieVerifier::statusToString(result.status);
+				procedure["time"] = result.time;
+				procedure["cached"] = result.cached;
+				procedure["solver"] = result.solver;
+				m_profiler->append("procedures", procedure);
+			}
+		}
+		// Procedures that could not be checked (e.g., Boogie could not be run) fail the compiler
+		for (auto const& result: results)
+			if (result.status == BoogieVerifier::Status::Failure)
+				m_error = true;
+	}
+
+	if (!tmpDir.empty())
+		fs::remove_all(tmpDir);
 }
 
 bool CommandLineInterface::actOnInput()
@@ -1370,9 +1650,35 @@ bool CommandLineInterface::actOnInput()
 		writeLinkedFiles();
 	else
 		outputCompilationResults();
+	if (m_profiler)
+		writeProfile();
 	return !m_error;
 }
 
+void CommandLineInterface::writeProfile()
+{
+	string path = m_args[g_strVerifyProfile].as<string>();
+	ofstream out(path);
+	out << jsonPrettyPrint(m_profiler->profile()) << endl;
+	if (!out)
+	{
+		serr() << "Could not write profile to file: " << path << endl;
+		m_error = true;
+	}
+}
+
+size_t CommandLineInterface::countASTNodes() const
+{
+	struct NodeCounter: ASTConstVisitor
+	{
+		bool visitNode(ASTNode const&) override { ++nodes; return true; }
+		size_t nodes = 0;
+	} counter;
+	for (auto const& sourceCode: m_sourceCodes)
+		m_compiler->ast(sourceCode.first).accept(counter);
+	return counter.nodes;
+}
+
 bool CommandLineInterface::link()
 {
 	// Map from how the libraries will be named inside the bytecode to their addresses.
@@ -21,6 +21,8 @@
  */
 #pragma once
 
+#include <solc/Profiler.h>
+
 #include <libsolidity/interface/CompilerStack.h>
 #include <libyul/AssemblyStack.h>
 #include <liblangutil/EVMVersion.h>
@@ -28,8 +30,14 @@
 #include <boost/program_options.hpp>
 #include <boost/filesystem/path.hpp>
 
+#include <functional>
 #include <memory>
 
+namespace boogie
+{
+class Program;
+}
+
 namespace dev
 {
 namespace solidity
@@ -64,6 +72,8 @@ private:
 	void handleCombinedJSON();
 	void handleAst(std::string const& _argStr);
 	void handleBoogie();
+	/// Verifies the procedures of the Boogie program using the parallel driver.
+	void handleBoogieVerification(boogie::Program& _program, std::string const& _programName);
 	void handleBinary(std::string const& _contract);
 	void handleOpcode(std::string const& _contract);
 	void handleIR(std::string const& _contract);
@@ -87,11 +97,21 @@ private:
 	/// @arg _data to be written
 	void createFile(std::string const& _fileName, std::string const& _data);
 
+	/// Create a file in the given directory without building its contents in memory
+	/// @arg _fileName the name of the file
+	/// @arg _write called with a (buffered) stream to the file
+	void createFile(std::string const& _fileName, std::function<void(std::ostream&)> const& _write);
+
 	/// Create a json file in the given directory
 	/// @arg _fileName the name of the file (the extension will be replaced with .json)
 	/// @arg _json json string to be written
 	void createJson(std::string const& _fileName, std::string const& _json);
 
+	/// Writes the profile to the file given by --verify-profile.
+	void writeProfile();
+	/// @returns the number of AST nodes in all sources.
+	size_t countASTNodes() const;
+
 	bool m_error = false; ///< If true, some error occurred.
 
 	bool m_onlyAssemble = false;
@@ -110,6 +130,8 @@ private:
 	std::map<std::string, h160> m_libraries;
 	/// Solidity compiler stack
 	std::unique_ptr<dev::solidity::CompilerStack> m_compiler;
+	/// Profile of the phases (if requested with --verify-profile)
+	std::unique_ptr<Profiler> m_profiler;
 	/// EVM version to use
 	langutil::EVMVersion m_evmVersion;
 	/// Whether or not to colorize diagnostics output.
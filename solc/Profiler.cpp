@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Records wall time and memory usage of the phases of a compiler run.
+ */
+#include <solc/Profiler.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#if defined(__linux__)
+#include <unistd.h>
+#include <fstream>
+#endif
+
+using namespace std;
+using namespace dev::solidity;
+
+void Profiler::start(string const& _name)
+{
+	stop();
+	m_current = _name;
+	m_startMemory = residentMemory();
+	m_start = chrono::steady_clock::now();
+}
+
+void Profiler::stop()
+{
+	if (m_current.empty())
+		return;
+	Json::Value phase(Json::objectValue);
+	phase["name"] = m_current;
+	phase["time"] = chrono::duration<double>(chrono::steady_clock::now() - m_start).count();
+	phase["memoryStart"] = Json::UInt64(m_startMemory);
+	phase["memoryEnd"] = Json::UInt64(residentMemory());
+	phase["peakMemory"] = Json::UInt64(peakMemory());
+	if (!m_counters.empty())
+		phase["counters"] = m_counters;
+	m_profile["phases"].append(phase);
+	m_current.clear();
+	m_counters = Json::Value(Json::objectValue);
+}
+
+void Profiler::count(string const& _name, uint64_t _value)
+{
+	if (!m_current.empty())
+		m_counters[_name] = Json::UInt64(_value);
+	else if (!m_profile["phases"].empty())
+		m_profile["phases"][m_profile["phases"].size() - 1]["counters"][_name] = Json::UInt64(_value);
+}
+
+void Profiler::append(string const& _name, Json::Value _entry)
+{
+	m_profile[_name].append(move(_entry));
+}
+
+uint64_t Profiler::peakMemory()
+{
+#if defined(__unix__) || defined(__APPLE__)
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	return uint64_t(usage.ru_maxrss); // Bytes on macOS
+#else
+	return uint64_t(usage.ru_maxrss) * 1024; // Kilobytes elsewhere
+#endif
+#else
+	return 0;
+#endif
+}
+
+uint64_t Profiler::residentMemory()
+{
+#if defined(__linux__)
+	// The second field is the resident set size in pages
+	ifstream statm("/proc/self/statm");
+	uint64_t size = 0;
+	uint64_t resident = 0;
+	if (!(statm >> size >> resident))
+		return 0;
+	return resident * uint64_t(sysconf(_SC_PAGESIZE));
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,69 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Records wall time and memory usage of the phases of a compiler run.
+ */
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <string>
+
+namespace dev
+{
+namespace solidity
+{
+
+/**
+ * Collects the profile of a run as JSON. Phases are recorded one after the other:
+ * starting a phase ends the previous one. For each phase the wall time, the resident
+ * memory at its start and end, the peak memory usage of the process so far and
+ * optional counters are recorded.
+ */
+class Profiler
+{
+public:
+	/// Starts phase @a _name, ending the current one.
+	void start(std::string const& _name);
+	/// Ends the current phase (if any).
+	void stop();
+	/// Sets counter @a _name of the current (or last) phase (e.g., number of nodes processed).
+	void count(std::string const& _name, uint64_t _value);
+	/// Adds @a _entry to the list @a _name of the profile (e.g., per procedure results).
+	void append(std::string const& _name, Json::Value _entry);
+
+	/// @returns the profile, containing the list of phases and the other lists.
+	Json::Value const& profile() const { return m_profile; }
+
+	/// @returns the peak memory usage (resident set size) of the process in bytes,
+	/// or 0 if not supported on the platform.
+	static uint64_t peakMemory();
+	/// @returns the current memory usage (resident set size) of the process in bytes,
+	/// or 0 if not supported on the platform.
+	static uint64_t residentMemory();
+
+private:
+	Json::Value m_profile{Json::objectValue};
+	std::string m_current; ///< Name of the current phase, empty if there is none.
+	Json::Value m_counters{Json::objectValue}; ///< Counters of the current phase.
+	std::chrono::steady_clock::time_point m_start;
+	uint64_t m_startMemory = 0; ///< Resident memory at the start of the current phase.
+};
+
+}
+}
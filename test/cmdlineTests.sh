@@ -376,6 +376,121 @@ SOLTMPDIR=$(mktemp -d)
 )
 rm -rf "$SOLTMPDIR"
 
+printTask "Testing the Boogie verifier..."
+SOLTMPDIR=$(mktemp -d)
+(
+    set -e
+    cd "$SOLTMPDIR"
+    mkdir bin
+    # Stands in for Boogie and logs its runs: z3 verifies every procedure, cvc4 reports errors
+    cat > bin/boogie <<'EOF'
+#!/usr/bin/env bash
+for arg in "$@"
+do
+    case "$arg" in
+        /proc:*) proc="${arg#/proc:}";;
+        /proverOpt:PROVER_PATH=*) prover=$(basename "${arg#*=}");;
+    esac
+done
+echo "$prover $proc" >> "$(dirname "$0")/../boogie.log"
+echo "Verifying $proc ..."
+if [[ "$prover" == "z3" ]]
+then
+    echo "  [0.1 s, 1 proof obligation]  verified"
+    echo
+    echo "Boogie program verifier finished with 1 verified, 0 errors"
+else
+    echo "  [0.1 s, 1 proof obligation]  error"
+    echo
+    echo "Boogie program verifier finished with 0 verified, 1 error"
+fi
+EOF
+    printf '#!/bin/sh\n' > bin/z3
+    printf '#!/bin/sh\n' > bin/cvc4
+    chmod +x bin/*
+    export PATH="$SOLTMPDIR/bin:$PATH"
+    touch boogie.log
+    printf 'pragma solidity >=0.5.0;\ncontract C {\n    uint x;\n    function set(uint y) public { x = y; }\n    function get() public view returns (uint) { return x; }\n}\n' > c.sol
+
+    function verify()
+    {
+        "$SOLC" c.sol --boogie --boogie-verify --boogie-exe "$SOLTMPDIR/bin/boogie" "$@" </dev/null >/dev/null 2>&1
+    }
+    # Checks the number of Boogie runs so far
+    function expect_runs()
+    {
+        if [[ $(wc -l < boogie.log) -ne "$1" ]]
+        then
+            printError "Expected $1 Boogie runs, but got:"
+            cat boogie.log
+            exit 1
+        fi
+    }
+
+    # Procedures fail (and so does the compiler) if Boogie cannot be run
+    set +e
+    "$SOLC" c.sol --boogie --boogie-verify --boogie-exe "$SOLTMPDIR/bin/missing" </dev/null >output.txt 2>errors.txt
+    exitCode=$?
+    set -e
+    if [[ $exitCode -eq 0 || $(grep -c '^error$' output.txt) -ne 3 ]] || ! grep -q '^Could not run verifier: ' errors.txt
+    then
+        printError "Incorrect response to a missing Boogie executable (exit code $exitCode):"
+        cat output.txt errors.txt
+        exit 1
+    fi
+
+    # The second run is answered from the cache
+    verify --boogie-cache cache --verify-profile profile.json
+    expect_runs 3
+    if grep -q '"cached": true' profile.json
+    then
+        printError "Results of the first run are marked cached."
+        exit 1
+    fi
+    verify --boogie-cache cache --verify-profile profile.json
+    expect_runs 3
+    [[ $(grep -c '"cached": true' profile.json) -eq 3 ]]
+
+    # Changing the timeout, the arithmetic or the solver misses the cache
+    verify --boogie-cache cache --boogie-timeout 5
+    expect_runs 6
+    verify --boogie-cache cache --boogie-arith mod
+    expect_runs 9
+    verify --boogie-cache cache --boogie-solver cvc4
+    expect_runs 12
+    verify --boogie-cache cache --boogie-solver cvc4
+    expect_runs 12
+
+    # Damaged entries are ignored and replaced
+    for entry in cache/*.json
+    do
+        echo '{"status": ' > "$entry"
+    done
+    verify --boogie-cache cache
+    expect_runs 15
+    verify --boogie-cache cache
+    expect_runs 15
+
+    # The winners are saved, and start alone in the next run
+    verify --boogie-portfolio cvc4 --boogie-portfolio-stats stats.json
+    [[ $(grep -c '"z3": 1' stats.json) -eq 3 ]]
+    if grep -q cvc4 stats.json
+    then
+        printError "A solver without proofs is counted as winner."
+        exit 1
+    fi
+    runs=$(wc -l < boogie.log)
+    verify --boogie-portfolio cvc4 --boogie-portfolio-stats stats.json
+    expect_runs $((runs + 3))
+    if tail -n 3 boogie.log | grep -q cvc4
+    then
+        printError "The rest of the portfolio started before the previous winner finished."
+        exit 1
+    fi
+    [[ $(grep -c '"z3": 2' stats.json) -eq 3 ]]
+)
+rm -rf "$SOLTMPDIR"
+
 printTask "Testing assemble, yul, strict-assembly and optimize..."
 (
     echo '{}' | "$SOLC" - --assemble &>/dev/null
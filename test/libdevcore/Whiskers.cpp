@@ -187,6 +187,18 @@ BOOST_AUTO_TEST_CASE(invalid_param)
 	BOOST_CHECK_THROW(m("b ", "X"), WhiskersError);
 }
 
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	// Parsed templates are shared, check that the values are not leaked between renders
+	string templ = "<?c><a><!c><#b>[<a><x>]</b></c>";
+	vector<map<string, string>> list(2);
+	list[0]["x"] = "1";
+	list[1]["x"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "A")("c", true)("b", list).render(), "A");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "B")("c", false)("b", list).render(), "[B1][B2]");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "C")("c", true)("b", list).render(), "C");
+}
+
 BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 {
 	string templ = "a <b >";
@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the interning of converted Boogie expressions.
+ */
+
+#include <libsolidity/boogie/ASTBoogieConverter.h>
+#include <libsolidity/boogie/ASTBoogieStats.h>
+#include <libsolidity/boogie/BoogieContext.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <test/Options.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+using namespace std;
+using namespace langutil;
+namespace bg = boogie;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(BoogieExprInterner)
+
+BOOST_AUTO_TEST_CASE(structurally_equal_expressions)
+{
+	bg::ExprInterner interner;
+	bg::Expr::Ref a = bg::Expr::id("a");
+	bg::Expr::Ref b = bg::Expr::id("b");
+
+	// Every kind of binary operator is interned with the other operands of the same kind
+	for (auto make: {&bg::Expr::eq, &bg::Expr::neq, &bg::Expr::lt, &bg::Expr::plus})
+	{
+		bg::Expr::Ref first = interner.intern(make(a, b));
+		BOOST_CHECK(interner.intern(make(a, b)) == first);
+		BOOST_CHECK(interner.intern(make(b, a)) != first);
+	}
+	BOOST_CHECK(interner.intern(bg::Expr::neq(a, b)) != interner.intern(bg::Expr::eq(a, b)));
+	BOOST_CHECK(interner.intern(bg::Expr::neg(a)) == interner.intern(bg::Expr::neg(a)));
+	BOOST_CHECK(bg::Expr::equals(bg::Expr::neq(a, b), bg::Expr::neq(a, b)));
+	BOOST_CHECK(!bg::Expr::equals(bg::Expr::neq(a, b), bg::Expr::eq(a, b)));
+}
+
+BOOST_AUTO_TEST_CASE(repeated_comparisons_in_contract)
+{
+	// All converted expressions go through the interner of the context,
+	// the repeated conditions are structurally equal to the first ones
+	string const source = R"(
+		pragma solidity >=0.5.0;
+		contract C {
+			address owner;
+			uint balance;
+			function f(address a, uint x) public {
+				require(a != owner);
+				require(a != owner);
+				require(x != balance && x != balance + 1);
+				assert(x != balance);
+				owner = a;
+			}
+		}
+	)";
+	CompilerStack compiler;
+	compiler.setSources({{"a", source}});
+	compiler.setEVMVersion(dev::test::Options::get().evmVersion());
+	BOOST_REQUIRE(compiler.parseAndAnalyze());
+
+	ASTBoogieStats stats;
+	compiler.ast("a").accept(stats);
+	ErrorList errors;
+	ErrorReporter errorReporter(errors);
+	BoogieContext context(BoogieContext::Encoding::INT, false, false, &errorReporter,
+			compiler.getScopes(), dev::test::Options::get().evmVersion(), stats);
+	context.currentScanner() = &compiler.scanner("a");
+	ASTBoogieConverter(context).convert(compiler.ast("a"));
+	BOOST_CHECK(Error::containsOnlyWarnings(errors));
+
+	ostringstream program;
+	context.print(program);
+	BOOST_CHECK(program.str().find("!=") != string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
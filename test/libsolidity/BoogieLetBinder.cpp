@@ -0,0 +1,124 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for binding repeated Boogie subexpressions to variables.
+ */
+
+#include <libsolidity/boogie/BoogieLetBinder.h>
+#include <libsolidity/boogie/BoogieAstDecl.h>
+#include <libsolidity/boogie/BoogieAstStmt.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+using namespace std;
+namespace bg = boogie;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+template <class T>
+string print(T const& t)
+{
+	ostringstream os;
+	os << t;
+	return os.str();
+}
+
+/** x[this] */
+bg::Expr::Ref balanceOfThis()
+{
+	return bg::Expr::arrsel(bg::Expr::id("x"), bg::Expr::id("this"));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BoogieLetBinder)
+
+BOOST_AUTO_TEST_CASE(repeated_subexpression)
+{
+	bg::Expr::Ref sum = bg::Expr::plus(balanceOfThis(), balanceOfThis());
+	bg::Expr::Ref expr = bg::Expr::and_(
+		bg::Expr::gt(sum, bg::Expr::id("y")),
+		bg::Expr::lt(sum, bg::Expr::id("z")));
+
+	BOOST_CHECK_EQUAL(print(bg::LetBinder().bind(expr)),
+		"(var __cse#1 := x[this]; (var __cse#2 := (__cse#1 + __cse#1); "
+		"((__cse#2 > y) && (__cse#2 < z))))");
+
+	// Variables and literals are not worth binding
+	bg::Expr::Ref simple = bg::Expr::plus(bg::Expr::id("y"), bg::Expr::id("y"));
+	BOOST_CHECK(bg::LetBinder().bind(simple) == simple);
+}
+
+BOOST_AUTO_TEST_CASE(quantifier_old_and_let_bodies)
+{
+	bg::Expr::Ref i = bg::Expr::id("i");
+	bg::Expr::Ref quantified = bg::Expr::forall({{i, bg::Decl::elementarytype("int")}},
+		bg::Expr::gt(bg::Expr::plus(balanceOfThis(), balanceOfThis()), i));
+	bg::Expr::Ref old = bg::Expr::old(bg::Expr::plus(balanceOfThis(), balanceOfThis()));
+	bg::Expr::Ref let = bg::Expr::let("v", balanceOfThis(), bg::Expr::plus(bg::Expr::id("v"), balanceOfThis()));
+
+	// Only the occurrences outside of the quantifier, old and let are bound
+	bg::Expr::Ref expr = bg::Expr::and_(
+		bg::Expr::and_(quantified, bg::Expr::eq(old, bg::Expr::plus(balanceOfThis(), balanceOfThis()))),
+		bg::Expr::eq(let, balanceOfThis()));
+	BOOST_CHECK_EQUAL(print(bg::LetBinder().bind(expr)),
+		"(var __cse#1 := x[this]; "
+		"(((forall i: int :: ((x[this] + x[this]) > i)) && (old((x[this] + x[this])) == (__cse#1 + __cse#1))) && "
+		"((var v := x[this]; (v + x[this])) == __cse#1)))");
+
+	// Repeated quantifiers, old and let expressions are left alone as well
+	for (auto const& leaf: {quantified, old, let})
+	{
+		bg::Expr::Ref twice = bg::Expr::or_(bg::Expr::eq(leaf, bg::Expr::id("y")), bg::Expr::eq(leaf, bg::Expr::id("z")));
+		BOOST_CHECK(bg::LetBinder().bind(twice) == twice);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(procedure_statements)
+{
+	bg::ProcDeclRef proc = bg::Decl::procedure("f", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::assume(bg::Expr::gt(balanceOfThis(), balanceOfThis())),
+		bg::Stmt::assign(bg::Expr::id("y"), bg::Expr::plus(balanceOfThis(), balanceOfThis())),
+		bg::Stmt::assert_(bg::Expr::neq(bg::Expr::id("y"), balanceOfThis()))
+	})});
+	bg::Program program;
+	program.getDeclarations().push_back(proc);
+
+	// Fresh variables are numbered across the statements, each statement is bound separately
+	bg::LetBinder().bind(program);
+	auto const& stmts = proc->getBlocks()[0]->getStatements();
+	BOOST_REQUIRE_EQUAL(stmts.size(), 3);
+	BOOST_CHECK_EQUAL(print(stmts[0]), "assume (var __cse#1 := x[this]; (__cse#1 > __cse#1));");
+	BOOST_CHECK_EQUAL(print(stmts[1]), "y := (var __cse#2 := x[this]; (__cse#2 + __cse#2));");
+	BOOST_CHECK_EQUAL(print(stmts[2]), "assert (y != x[this]);");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
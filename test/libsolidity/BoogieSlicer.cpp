@@ -0,0 +1,182 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for slicing Boogie programs per procedure.
+ */
+
+#include <libsolidity/boogie/BoogieSlicer.h>
+#include <libsolidity/boogie/BoogieAstStmt.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+using namespace std;
+namespace bg = boogie;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/** Describes a declaration of a slice by its name, axioms by their text */
+string describe(bg::Decl::Ref const& decl)
+{
+	if (decl->getKind() != bg::Decl::AXIOM)
+		return decl->getName();
+	ostringstream os;
+	decl->print(os);
+	return os.str();
+}
+
+bg::ProcDeclRef findProcedure(bg::Program& program, string const& name)
+{
+	for (auto const& decl: program.getDeclarations())
+		if (decl->getKind() == bg::Decl::PROCEDURE && decl->getName() == name)
+			return dynamic_pointer_cast<bg::ProcDecl>(decl);
+	return nullptr;
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(BoogieSlicer)
+
+BOOST_AUTO_TEST_CASE(reachable_declarations)
+{
+	bg::TypeDeclRef intType = bg::Decl::elementarytype("int");
+	bg::TypeDeclRef addressType = bg::Decl::customtype("address_t");
+	bg::Binding param{bg::Expr::id("i"), intType};
+
+	bg::Decl::Ref c = bg::Decl::constant("c", intType);
+	bg::Decl::Ref d = bg::Decl::constant("d", intType);
+	// Only used in an axiom that constrains a reached constant
+	bg::Decl::Ref g = bg::Decl::function("g", {param}, intType);
+	bg::Decl::Ref h = bg::Decl::function("h", {param}, intType);
+	bg::Decl::Ref reachedAxiom = bg::Decl::axiom(bg::Expr::eq(bg::Expr::fn("g", bg::Expr::id("c")), bg::Expr::id("c")));
+	bg::Decl::Ref unreachedAxiom = bg::Decl::axiom(bg::Expr::gt(bg::Expr::id("d"), bg::Expr::fn("h", bg::Expr::id("d"))));
+
+	// Modifies a global, only called from the body of another procedure
+	bg::ProcDeclRef setter = bg::Decl::procedure("setter", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::assign(bg::Expr::id("count"), bg::Expr::plus(bg::Expr::id("count"), bg::Expr::intlit(bg::bigint(1))))
+	})});
+	bg::ProcDeclRef callee = bg::Decl::procedure("callee", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::call("setter")
+	})});
+	bg::ProcDeclRef helper = bg::Decl::procedure("helper", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::havoc("other")
+	})});
+	helper->addAttr(bg::Attr::attr("inline", 1));
+	// Body-less procedure with an explicit modifies clause
+	bg::ProcDeclRef external = bg::Decl::procedure("external");
+	external->getModifies().push_back("owner");
+	bg::ProcDeclRef main = bg::Decl::procedure("main", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::assume(bg::Expr::gt(bg::Expr::id("c"), bg::Expr::intlit(bg::bigint(0)))),
+		bg::Stmt::call("callee"),
+		bg::Stmt::call("external"),
+		bg::Stmt::call("helper")
+	})});
+	bg::ProcDeclRef unrelated = bg::Decl::procedure("unrelated", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::assign(bg::Expr::id("other"), bg::Expr::id("d"))
+	})});
+
+	bg::Program program;
+	program.getDeclarations() = {
+		addressType, bg::Decl::customtype("unused_t"),
+		bg::Decl::variable("owner", addressType), bg::Decl::variable("count", intType), bg::Decl::variable("other", intType),
+		c, d, g, h, reachedAxiom, unreachedAxiom,
+		setter, callee, helper, external, main, unrelated
+	};
+
+	bg::ProgramSlicer slicer(program);
+	bg::Program slice = slicer.slice(main);
+
+	vector<string> names;
+	for (auto const& decl: slice.getDeclarations())
+		names.push_back(describe(decl));
+	vector<string> expected{
+		"address_t", "owner", "count", "other", "c", "g", describe(reachedAxiom),
+		"callee", "helper", "external", "main"
+	};
+	BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expected.begin(), expected.end());
+
+	// Called procedures are declared only, with the globals modified by their callees
+	bg::ProcDeclRef slicedCallee = findProcedure(slice, "callee");
+	BOOST_REQUIRE(slicedCallee);
+	BOOST_CHECK(slicedCallee->getBlocks().empty());
+	BOOST_CHECK(slicedCallee->getModifies() == vector<string>{"count"});
+	BOOST_CHECK(callee->getModifies().empty());
+	BOOST_CHECK(callee->getBlocks().size() == 1);
+
+	bg::ProcDeclRef slicedExternal = findProcedure(slice, "external");
+	BOOST_REQUIRE(slicedExternal);
+	BOOST_CHECK(slicedExternal->getModifies() == vector<string>{"owner"});
+
+	// Inlined and sliced procedures keep their implementation
+	BOOST_CHECK(findProcedure(slice, "helper") == helper);
+	BOOST_CHECK(findProcedure(slice, "main") == main);
+}
+
+BOOST_AUTO_TEST_CASE(modifies_fixpoint_through_recursion)
+{
+	bg::TypeDeclRef intType = bg::Decl::elementarytype("int");
+
+	// Mutually recursive procedures, only one of them modifies a global directly
+	bg::ProcDeclRef even = bg::Decl::procedure("even", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::call("odd"),
+		bg::Stmt::call("even")
+	})});
+	bg::ProcDeclRef odd = bg::Decl::procedure("odd", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::call("last"),
+		bg::Stmt::havoc("x")
+	})});
+	bg::ProcDeclRef last = bg::Decl::procedure("last", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::assign(bg::Expr::arrsel(bg::Expr::id("m"), bg::Expr::intlit(bg::bigint(0))), bg::Expr::intlit(bg::bigint(1)))
+	})});
+	bg::ProcDeclRef main = bg::Decl::procedure("main", {}, {}, {}, {bg::Block::block("", {
+		bg::Stmt::call("even")
+	})});
+
+	bg::Program program;
+	program.getDeclarations() = {
+		bg::Decl::variable("x", intType),
+		bg::Decl::variable("m", bg::Decl::arraytype(intType, intType)),
+		even, odd, last, main
+	};
+
+	bg::Program slice = bg::ProgramSlicer(program).slice(main);
+	vector<string> names;
+	for (auto const& decl: slice.getDeclarations())
+		names.push_back(describe(decl));
+	vector<string> expected{"x", "m", "even", "main"};
+	BOOST_CHECK_EQUAL_COLLECTIONS(names.begin(), names.end(), expected.begin(), expected.end());
+
+	bg::ProcDeclRef slicedEven = findProcedure(slice, "even");
+	BOOST_REQUIRE(slicedEven);
+	set<string> mods(slicedEven->getModifies().begin(), slicedEven->getModifies().end());
+	BOOST_CHECK(mods == (set<string>{"m", "x"}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -333,6 +333,62 @@ BOOST_AUTO_TEST_CASE(import_library)
 
 }
 
+BOOST_AUTO_TEST_CASE(model_checker_jobs_do_not_change_warnings)
+{
+	// Several targets of different kinds per function, so that the jobs check them concurrently
+	StringMap sources{{"a", R"(
+		pragma solidity >=0.0;
+		pragma experimental SMTChecker;
+		contract A {
+			uint x;
+			function f(uint a, uint b) public returns (uint) {
+				x = a + b;
+				assert(x > a);
+				return a / b;
+			}
+			function g(uint a) public view returns (uint) {
+				require(a < 10);
+				assert(a < 5);
+				if (a == 11)
+					return 0;
+				return x - a;
+			}
+		}
+		contract B {
+			function h(uint[] memory a, uint i, bool c) public pure returns (uint) {
+				assert(a.length > i);
+				while (c) {}
+				return a[i] * 2;
+			}
+		}
+	)"}};
+	auto warnings = [&](unsigned _jobs)
+	{
+		CompilerStack c;
+		c.setSources(sources);
+		c.setEVMVersion(dev::test::Options::get().evmVersion());
+		c.setModelCheckerJobs(_jobs);
+		BOOST_REQUIRE(c.compile());
+		vector<string> messages;
+		for (auto const& e: c.errors())
+		{
+			string const* msg = e->comment();
+			BOOST_REQUIRE(msg);
+			auto location = boost::get_error_info<errinfo_sourceLocation>(*e);
+			messages.push_back((location ? to_string(location->start) + ": " : string()) + *msg);
+		}
+		return messages;
+	};
+
+	vector<string> serial = warnings(1);
+	BOOST_CHECK(serial.size() >= 6);
+	for (unsigned jobs: {2u, 4u})
+	{
+		vector<string> parallel = warnings(jobs);
+		BOOST_CHECK_EQUAL_COLLECTIONS(parallel.begin(), parallel.end(), serial.begin(), serial.end());
+	}
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the SMT-LIB2 output of the SMTChecker.
+ */
+
+#include <libsolidity/formal/SMTLib2Interface.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTLib2Interface)
+
+BOOST_AUTO_TEST_CASE(unshared_subterms)
+{
+	smt::SMTLib2Interface solver({});
+	auto intSort = make_shared<smt::Sort>(smt::Kind::Int);
+	smt::Expression x = solver.newVariable("x", intSort);
+	smt::Expression y = solver.newVariable("y", intSort);
+	// Variables and constants are not bound
+	BOOST_CHECK_EQUAL(solver.toSExpr((x + y) * (x - smt::Expression(size_t(2)))), "(* (+ x y) (- x 2))");
+}
+
+BOOST_AUTO_TEST_CASE(shared_subterm)
+{
+	smt::SMTLib2Interface solver({});
+	auto intSort = make_shared<smt::Sort>(smt::Kind::Int);
+	smt::Expression x = solver.newVariable("x", intSort);
+	smt::Expression y = solver.newVariable("y", intSort);
+	// Built twice, hash-consing gives the same node
+	smt::Expression sum = x + y;
+	BOOST_CHECK_EQUAL(solver.toSExpr((x + y) * sum > sum), "(let ((_e.0 (+ x y))) (> (* _e.0 _e.0) _e.0))");
+}
+
+BOOST_AUTO_TEST_CASE(nested_shared_subterms)
+{
+	smt::SMTLib2Interface solver({});
+	auto intSort = make_shared<smt::Sort>(smt::Kind::Int);
+	smt::Expression x = solver.newVariable("x", intSort);
+	smt::Expression y = solver.newVariable("y", intSort);
+	smt::Expression sum = x + y;
+	smt::Expression product = sum * smt::Expression(size_t(2));
+	// The binding of the product refers to the binding of the sum
+	BOOST_CHECK_EQUAL(
+		solver.toSExpr(product + product > sum),
+		"(let ((_e.0 (+ x y))) (let ((_e.1 (* _e.0 2))) (> (+ _e.1 _e.1) _e.0)))"
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -0,0 +1,152 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the persistent cache of SMT solver responses.
+ */
+
+#include <libsolidity/formal/SMTQueryCache.h>
+
+#include <libdevcore/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+namespace dev
+{
+namespace solidity
+{
+namespace test
+{
+
+namespace
+{
+
+/// Cache directory that is removed at the end of the test.
+struct CacheDirectoryFixture
+{
+	CacheDirectoryFixture(): directory(fs::temp_directory_path() / fs::unique_path("solc-smt-cache-%%%%-%%%%")) {}
+	~CacheDirectoryFixture()
+	{
+		boost::system::error_code error;
+		fs::remove_all(directory, error);
+	}
+
+	/// @returns the files in the cache directory.
+	vector<fs::path> entries() const
+	{
+		vector<fs::path> files;
+		for (auto const& entry: fs::directory_iterator(directory))
+			files.push_back(entry.path());
+		return files;
+	}
+
+	fs::path directory;
+	h256 const query = keccak256("(check-sat)\n");
+};
+
+}
+
+BOOST_FIXTURE_TEST_SUITE(SMTQueryCache, CacheDirectoryFixture)
+
+BOOST_AUTO_TEST_CASE(miss)
+{
+	smt::SMTQueryCache cache(directory);
+	BOOST_CHECK(!cache.lookup(query, "z3-4.8.7"));
+	cache.store(query, "z3-4.8.7", "unsat\n");
+	BOOST_CHECK(!cache.lookup(keccak256("(check-sat)\n(get-value (x))\n"), "z3-4.8.7"));
+}
+
+BOOST_AUTO_TEST_CASE(hit)
+{
+	smt::SMTQueryCache(directory).store(query, "z3-4.8.7", "sat\n((x 1))\n");
+	// Entries are kept between instances, i.e. compiler runs
+	auto response = smt::SMTQueryCache(directory).lookup(query, "z3-4.8.7");
+	BOOST_REQUIRE(response);
+	BOOST_CHECK_EQUAL(*response, "sat\n((x 1))\n");
+	// Storing again replaces the entry
+	smt::SMTQueryCache(directory).store(query, "z3-4.8.7", "unsat\n");
+	BOOST_CHECK_EQUAL(entries().size(), 1);
+	BOOST_CHECK(smt::SMTQueryCache(directory).lookup(query, "z3-4.8.7") == string("unsat\n"));
+}
+
+BOOST_AUTO_TEST_CASE(solver_identity_in_key)
+{
+	smt::SMTQueryCache cache(directory);
+	cache.store(query, "z3-4.8.7-rlimit40000000", "sat\n");
+	BOOST_CHECK(!cache.lookup(query, "cvc4-1.7-rlimit10000"));
+	BOOST_CHECK(!cache.lookup(query, "z3-4.8.6-rlimit40000000"));
+	cache.store(query, "cvc4-1.7-rlimit10000", "unknown\n");
+	BOOST_CHECK_EQUAL(entries().size(), 2);
+	BOOST_CHECK(cache.lookup(query, "z3-4.8.7-rlimit40000000") == string("sat\n"));
+	BOOST_CHECK(cache.lookup(query, "cvc4-1.7-rlimit10000") == string("unknown\n"));
+}
+
+BOOST_AUTO_TEST_CASE(damaged_entries)
+{
+	smt::SMTQueryCache cache(directory);
+	cache.store(query, "z3", "sat\n((x 1))\n");
+	BOOST_REQUIRE_EQUAL(entries().size(), 1);
+	fs::path entry = entries().front();
+
+	// Truncated, e.g. by a full disk
+	string content;
+	{
+		ifstream file(entry.string(), ios::binary);
+		content.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+	}
+	ofstream(entry.string(), ios::binary | ios::trunc) << content.substr(0, content.size() - 3);
+	BOOST_CHECK(!cache.lookup(query, "z3"));
+
+	// Without the hash of the response
+	ofstream(entry.string(), ios::binary | ios::trunc) << "sat\n";
+	BOOST_CHECK(!cache.lookup(query, "z3"));
+
+	// Empty
+	ofstream(entry.string(), ios::binary | ios::trunc);
+	BOOST_CHECK(!cache.lookup(query, "z3"));
+
+	// Damaged entries are replaced by the next answer
+	cache.store(query, "z3", "unsat\n");
+	BOOST_CHECK(cache.lookup(query, "z3") == string("unsat\n"));
+}
+
+BOOST_AUTO_TEST_CASE(external_solver)
+{
+	map<h256, string> responses{{query, "unsat\n"}};
+
+	// Responses of an unknown solver are not kept
+	smt::SMTQueryCache unnamed(directory);
+	unnamed.storeExternal(responses);
+	BOOST_CHECK(!fs::exists(directory));
+	BOOST_CHECK(!unnamed.lookupExternal(query));
+
+	smt::SMTQueryCache(directory, "z3 -smt2 -in 4.8.7").storeExternal(responses);
+	BOOST_CHECK(smt::SMTQueryCache(directory, "z3 -smt2 -in 4.8.7").lookupExternal(query) == string("unsat\n"));
+	BOOST_CHECK(!smt::SMTQueryCache(directory, "cvc4 --lang smt2 1.7").lookupExternal(query));
+	BOOST_CHECK(!smt::SMTQueryCache(directory).lookupExternal(query));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
+}
+}
@@ -53,6 +53,69 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(compilation_jobs_do_not_change_output)
+{
+	// Contracts creating other contracts embed their code as subassemblies,
+	// so the workers depend on each other.
+	StringMap sources{
+		{"a.sol", R"(
+			pragma solidity >=0.0;
+			import "b.sol";
+			contract A { B b = new B(); function f() public returns (C) { return new C(); } }
+		)"},
+		{"b.sol", R"(
+			pragma solidity >=0.0;
+			contract B { function g() public pure returns (uint) { return 7; } }
+			contract C is B { B b; constructor() public { b = new B(); } }
+			library L { function l(uint x) public pure returns (uint) { return x * 2; } }
+		)"},
+		{"c.sol", R"(
+			pragma solidity >=0.0;
+			import "a.sol";
+			contract D {
+				A a = new A();
+				C c = new C();
+				function h(uint x) public returns (uint) { return L.l(c.g() + x); }
+			}
+		)"}
+	};
+	struct Output
+	{
+		bytes creation;
+		bytes runtime;
+		string metadata;
+	};
+	auto compile = [&](unsigned _jobs)
+	{
+		CompilerStack compiler;
+		compiler.setSources(sources);
+		compiler.setEVMVersion(dev::test::Options::get().evmVersion());
+		compiler.setOptimiserSettings(dev::test::Options::get().optimize);
+		compiler.setCompilationJobs(_jobs);
+		BOOST_REQUIRE_MESSAGE(compiler.compile(), "Compiling contracts failed");
+		map<string, Output> outputs;
+		for (string const& name: compiler.contractNames())
+			outputs[name] = {compiler.object(name).bytecode, compiler.runtimeObject(name).bytecode, compiler.metadata(name)};
+		return outputs;
+	};
+
+	map<string, Output> serial = compile(1);
+	BOOST_REQUIRE_EQUAL(serial.size(), 5);
+	for (unsigned jobs: {2u, 4u})
+	{
+		map<string, Output> parallel = compile(jobs);
+		BOOST_REQUIRE_EQUAL(parallel.size(), serial.size());
+		for (auto const& output: serial)
+		{
+			BOOST_REQUIRE(parallel.count(output.first));
+			Output const& other = parallel.at(output.first);
+			BOOST_CHECK_MESSAGE(other.creation == output.second.creation, output.first + ": creation bytecode differs");
+			BOOST_CHECK_MESSAGE(other.runtime == output.second.runtime, output.first + ": runtime bytecode differs");
+			BOOST_CHECK_EQUAL(other.metadata, output.second.metadata);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
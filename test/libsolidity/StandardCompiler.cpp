@@ -19,8 +19,12 @@
  * Unit tests for interface/StandardCompiler.h.
  */
 
+#include <map>
 #include <string>
+#include <thread>
 #include <boost/test/unit_test.hpp>
+#include <libsolidity/interface/CompilationContext.h>
+#include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libdevcore/JSON.h>
@@ -1372,6 +1376,115 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(compilation_reuse)
+{
+	map<string, string> files{
+		{"lib.sol", "pragma solidity >=0.0; library L { function f(uint x) internal pure returns (uint) { return x * 3; } }"}
+	};
+	ReadCallback::Callback reader = [&](string const& _path) {
+		if (files.count(_path))
+			return ReadCallback::Result{true, files.at(_path)};
+		return ReadCallback::Result{false, "not found"};
+	};
+	auto input = [](string const& _source, string const& _outputs) {
+		return R"({
+			"language": "Solidity",
+			"sources": { "A": { "content": ")" + _source + R"(" } },
+			"settings": { "outputSelection": )" + _outputs + R"( }
+		})";
+	};
+	string const source =
+		"pragma solidity >=0.0; import \\\"lib.sol\\\"; "
+		"contract C { function f(uint x) public pure returns (uint) { return L.f(x); } } "
+		"contract D { function g() public returns (address) { return address(new C()); } }";
+	vector<string> const outputs{
+		R"({ "*": { "*": ["abi"], "": ["ast"] } })",
+		R"({ "A": { "C": ["evm.bytecode.object"] } })",
+		R"({ "*": { "*": ["evm.bytecode.object", "evm.deployedBytecode", "metadata"] } })",
+		R"({ "*": { "*": ["abi"], "": ["ast"] } })"
+	};
+
+	dev::solidity::StandardCompiler compiler(reader);
+	compiler.setCompilationCacheSize(2);
+	for (string const& output: outputs)
+	{
+		string expectation = dev::solidity::StandardCompiler(reader).compile(input(source, output));
+		BOOST_CHECK_EQUAL(compiler.compile(input(source, output)), expectation);
+	}
+
+	// A changed import is noticed although the input is the same.
+	files["lib.sol"] = "pragma solidity >=0.0; library L { function f(uint x) internal pure returns (uint) { return x * 5; } }";
+	string expectation = dev::solidity::StandardCompiler(reader).compile(input(source, outputs[2]));
+	BOOST_CHECK_EQUAL(compiler.compile(input(source, outputs[2])), expectation);
+
+	// Inputs with errors are not kept, but still compiled every time.
+	string const invalid = "pragma solidity >=0.0; contract E { function f() public { x; } }";
+	expectation = dev::solidity::StandardCompiler(reader).compile(input(invalid, outputs[0]));
+	BOOST_CHECK(expectation.find("Undeclared identifier") != string::npos);
+	BOOST_CHECK_EQUAL(compiler.compile(input(invalid, outputs[0])), expectation);
+	BOOST_CHECK_EQUAL(compiler.compile(input(invalid, outputs[0])), expectation);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_compilation)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{
+			"A":
+			{
+				"content": "pragma solidity >=0.0; pragma experimental ABIEncoderV2; import \"B\"; contract C is D { function g(uint x) public pure returns (bytes32) { assembly { x := add(x, 1) } return keccak256(abi.encode(f(x))); } }"
+			},
+			"B":
+			{
+				"content": "pragma solidity >=0.0; contract D { function f(uint x) public pure returns (uint) { return x * 7; } }"
+			}
+		},
+		"settings":
+		{
+			"optimizer": { "enabled": true, "details": { "yul": true } },
+			"outputSelection":
+			{
+				"*": { "*": ["abi", "evm.bytecode.object", "evm.methodIdentifiers"], "": ["ast"] }
+			}
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(jsonParseStrict(input, parsedInput));
+
+	// Each input is compiled in its own context, concurrent compilations
+	// must give the same output as a compilation on its own.
+	vector<string> results(4);
+	vector<thread> threads;
+	for (auto& result: results)
+		threads.emplace_back([&] { result = jsonCompactPrint(dev::solidity::StandardCompiler().compile(parsedInput)); });
+	for (auto& thread: threads)
+		thread.join();
+
+	string expectation = jsonCompactPrint(dev::solidity::StandardCompiler().compile(parsedInput));
+	BOOST_REQUIRE(expectation.find("\"bytecode\"") != string::npos);
+	for (auto const& result: results)
+		BOOST_CHECK_EQUAL(result, expectation);
+}
+
+BOOST_AUTO_TEST_CASE(compiler_stacks_per_context)
+{
+	CompilationContext context;
+	CompilationContext::Scope scope(context);
+	CompilerStack stack;
+	// Stacks in the same context would share the types
+	BOOST_CHECK_THROW(CompilerStack(), langutil::InternalCompilerError);
+
+	CompilationContext otherContext;
+	CompilationContext::Scope otherScope(otherContext);
+	CompilerStack otherStack;
+	otherStack.setSources({{"A", "pragma solidity >=0.0; contract C { function f() public pure {} }"}});
+	BOOST_CHECK(otherStack.parseAndAnalyze());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
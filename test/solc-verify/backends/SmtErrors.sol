@@ -0,0 +1,36 @@
+pragma solidity >=0.5.0;
+
+// Failures found by the smt backend are confirmed by Boogie, which
+// reports them with their locations, so the results are the same.
+contract SmtErrors {
+    uint x;
+
+    // OK
+    function correct(uint a, uint b) public pure {
+        require(a < b);
+        assert(a != b);
+    }
+
+    // WRONG: a < b does not imply a > b
+    function incorrectAssert(uint a, uint b) public pure {
+        require(a < b);
+        assert(a > b);
+    }
+
+    // WRONG: postcondition does not hold
+    /// @notice postcondition x == __verifier_old_uint(x)
+    function incorrectPost(uint d) public {
+        require(d > 0);
+        x = x + d;
+    }
+
+    // WRONG: precondition of the callee
+    function incorrectCall(uint d) public {
+        set(d);
+    }
+
+    /// @notice precondition d < 10
+    function set(uint d) public {
+        x = d;
+    }
+}
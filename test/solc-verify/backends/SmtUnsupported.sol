@@ -0,0 +1,21 @@
+pragma solidity >=0.5.0;
+
+// Storage arrays (encoded as datatypes) and quantified specifications are
+// outside of the fragment of the smt backend, so Boogie verifies these functions.
+
+/// @notice invariant forall (uint i) !(0 <= i && i < a.length) || (a[i] >= 0)
+contract SmtUnsupported {
+
+    int[] a;
+
+    // OK
+    function add(int d) public {
+        require(d >= 0);
+        a.push(d);
+    }
+
+    // WRONG: might insert negative element
+    function add_incorrect(int d) public {
+        a.push(d);
+    }
+}
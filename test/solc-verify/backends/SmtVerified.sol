@@ -0,0 +1,44 @@
+pragma solidity >=0.5.0;
+
+// Functions that the smt backend proves without running Boogie. The
+// implicit constructor uses builtin functions, so it falls back to Boogie.
+contract SmtVerified {
+    uint total;
+    mapping(address=>uint) balances;
+
+    // OK
+    function add(uint x) public {
+        require(x < 1000);
+        uint old = total;
+        total = total + x;
+        assert(total == old + x);
+    }
+
+    // OK
+    function max(uint a, uint b) public pure returns (uint) {
+        uint m = a;
+        if (b > a) m = b;
+        assert(m >= a && m >= b);
+        return m;
+    }
+
+    // OK
+    function deposit(uint amount) public {
+        require(msg.sender != address(this));
+        uint before = balances[msg.sender];
+        balances[msg.sender] += amount;
+        assert(balances[msg.sender] == before + amount);
+        assert(balances[address(this)] == balances[address(this)]);
+    }
+
+    /// @notice postcondition r == a + 1
+    function inc(uint a) public pure returns (uint r) {
+        r = a;
+        r++;
+    }
+
+    // OK
+    function callsInc(uint a) public pure {
+        assert(inc(a) == a + 1);
+    }
+}
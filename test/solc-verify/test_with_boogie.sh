@@ -131,6 +131,10 @@ for filename in $(find $SOLCVERIFY_TESTS -name '*.sol' | sort); do
     fi
     # Run the test
 	solcverify_check "$filename" "$flags" "$filename.gold"
+    # The smt backend must give the same results as Boogie
+    if [[ "$flags" == *"--backend smt"* ]]; then
+        solcverify_check "$filename" "${flags/--backend smt/--backend boogie}" "$filename.gold"
+    fi
 done
 
 # Remove temps
@@ -64,12 +64,25 @@ u256 readZeroExtended(bytes const& _data, u256 const& _offset)
 /// @a _target at offset @a _targetOffset. Behaves as if @a _source would
 /// continue with an infinite sequence of zero bytes beyond its end.
 void copyZeroExtended(
-	map<u256, uint8_t>& _target, bytes const& _source,
+	Memory& _target, bytes const& _source,
 	size_t _targetOffset, size_t _sourceOffset, size_t _size
 )
 {
-	for (size_t i = 0; i < _size; ++i)
-		_target[_targetOffset + i] = _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0;
+	// The target offsets wrap around at the size of size_t.
+	if (_targetOffset + _size < _targetOffset || _sourceOffset + _size < _sourceOffset)
+	{
+		for (size_t i = 0; i < _size; ++i)
+			_target.set(_targetOffset + i, _sourceOffset + i < _source.size() ? _source[_sourceOffset + i] : 0);
+		return;
+	}
+	size_t available = _sourceOffset < _source.size() ? min(_size, _source.size() - _sourceOffset) : 0;
+	if (available > 0)
+		_target.write(_targetOffset, _source.data() + _sourceOffset, available);
+	if (available < _size)
+	{
+		bytes zeros(_size - available, 0);
+		_target.write(u256(_targetOffset) + available, zeros.data(), zeros.size());
+	}
 }
 
 }
@@ -260,7 +273,7 @@ u256 EVMInstructionInterpreter::eval(
 		return 0;
 	case Instruction::MSTORE8:
 		accessMemory(arg[0], 1);
-		m_state.memory[arg[0]] = uint8_t(arg[1] & 0xff);
+		m_state.memory.set(arg[0], uint8_t(arg[1] & 0xff));
 		return 0;
 	case Instruction::SLOAD:
 		return m_state.storage[h256(arg[0])];
@@ -467,20 +480,18 @@ bytes EVMInstructionInterpreter::readMemory(u256 const& _offset, u256 const& _si
 {
 	yulAssert(_size <= 0xffff, "Too large read.");
 	bytes data(size_t(_size), uint8_t(0));
-	for (size_t i = 0; i < data.size(); ++i)
-		data[i] = m_state.memory[_offset + i];
+	m_state.memory.read(_offset, data.data(), data.size());
 	return data;
 }
 
 u256 EVMInstructionInterpreter::readMemoryWord(u256 const& _offset)
 {
-	return u256(h256(readMemory(_offset, 32)));
+	return m_state.memory.readWord(_offset);
 }
 
 void EVMInstructionInterpreter::writeMemoryWord(u256 const& _offset, u256 const& _value)
 {
-	for (size_t i = 0; i < 32; i++)
-		m_state.memory[_offset + i] = uint8_t((_value >> (8 * (31 - i))) & 0xff);
+	m_state.memory.writeWord(_offset, _value);
 }
 
 
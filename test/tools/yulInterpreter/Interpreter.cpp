@@ -35,7 +35,10 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 #include <boost/algorithm/cxx11/all_of.hpp>
+#include <boost/functional/hash.hpp>
 
+#include <algorithm>
+#include <cstring>
 #include <ostream>
 #include <variant>
 
@@ -44,22 +47,138 @@ using namespace dev;
 using namespace yul;
 using namespace yul::test;
 
+namespace
+{
+
+/// Calls @a _visitor with the page index, the offset in the page, the position in the
+/// range and the size of each part of the range of @a _size bytes starting at @a _offset
+/// that lies in a single page.
+template <class Visitor>
+void forEachPageOfRange(u256 _offset, size_t _size, Visitor const& _visitor)
+{
+	size_t position = 0;
+	while (position < _size)
+	{
+		size_t offsetInPage = size_t(_offset % Memory::c_pageSize);
+		size_t size = min(_size - position, Memory::c_pageSize - offsetInPage);
+		_visitor(_offset / Memory::c_pageSize, offsetInPage, position, size);
+		position += size;
+		// Wraps around at the end of the address space.
+		_offset += size;
+	}
+}
+
+}
+
+uint8_t Memory::get(u256 const& _offset) const
+{
+	Page const* data = page(_offset / c_pageSize);
+	return data ? (*data)[size_t(_offset % c_pageSize)] : 0;
+}
+
+void Memory::set(u256 const& _offset, uint8_t _value)
+{
+	write(_offset, &_value, 1);
+}
+
+void Memory::read(u256 const& _offset, uint8_t* _data, size_t _size) const
+{
+	forEachPageOfRange(_offset, _size, [&](u256 const& _index, size_t _offsetInPage, size_t _position, size_t _partSize)
+	{
+		if (Page const* data = page(_index))
+			memcpy(_data + _position, data->data() + _offsetInPage, _partSize);
+		else
+			memset(_data + _position, 0, _partSize);
+	});
+}
+
+void Memory::write(u256 const& _offset, uint8_t const* _data, size_t _size)
+{
+	forEachPageOfRange(_offset, _size, [&](u256 const& _index, size_t _offsetInPage, size_t _position, size_t _partSize)
+	{
+		uint8_t const* part = _data + _position;
+		if (page(_index) || any_of(part, part + _partSize, [](uint8_t _byte) { return _byte != 0; }))
+			memcpy(allocatePage(_index).data() + _offsetInPage, part, _partSize);
+	});
+}
+
+u256 Memory::readWord(u256 const& _offset) const
+{
+	h256 word;
+	read(_offset, word.data(), h256::size);
+	return u256(word);
+}
+
+void Memory::writeWord(u256 const& _offset, u256 const& _value)
+{
+	h256 word(_value);
+	write(_offset, word.data(), h256::size);
+}
+
+void Memory::forEachPage(function<void(u256 const&, Page const&)> const& _visitor) const
+{
+	for (size_t index = 0; index < m_flatPages.size(); ++index)
+		if (m_flatPages[index])
+			_visitor(index, *m_flatPages[index]);
+	for (auto const& [index, data]: m_sparsePages)
+		_visitor(index, *data);
+}
+
+Memory::Page const* Memory::page(u256 const& _index) const
+{
+	if (_index < c_flatPages)
+	{
+		size_t index = size_t(_index);
+		return index < m_flatPages.size() ? m_flatPages[index].get() : nullptr;
+	}
+	auto it = m_sparsePages.find(_index);
+	return it == m_sparsePages.end() ? nullptr : it->second.get();
+}
+
+Memory::Page& Memory::allocatePage(u256 const& _index)
+{
+	unique_ptr<Page>* data = nullptr;
+	if (_index < c_flatPages)
+	{
+		size_t index = size_t(_index);
+		if (index >= m_flatPages.size())
+			m_flatPages.resize(index + 1);
+		data = &m_flatPages[index];
+	}
+	else
+		data = &m_sparsePages[_index];
+	if (!*data)
+		*data = make_unique<Page>(Page{});
+	return **data;
+}
+
+size_t StorageSlotHash::operator()(h256 const& _slot) const
+{
+	return boost::hash_range(_slot.data(), _slot.data() + h256::size);
+}
+
 void InterpreterState::dumpTraceAndState(ostream& _out) const
 {
 	_out << "Trace:" << endl;
 	for (auto const& line: trace)
 		_out << "  " << line << endl;
 	_out << "Memory dump:\n";
-	map<u256, u256> words;
-	for (auto const& [offset, value]: memory)
-		words[(offset / 0x20) * 0x20] |= u256(uint32_t(value)) << (256 - 8 - 8 * size_t(offset % 0x20));
-	for (auto const& [offset, value]: words)
-		if (value != 0)
-			_out << "  " << std::uppercase << std::hex << std::setw(4) << offset << ": " << h256(value).hex() << endl;
+	memory.forEachPage([&](u256 const& _index, Memory::Page const& _page)
+	{
+		for (size_t offset = 0; offset < Memory::c_pageSize; offset += 0x20)
+		{
+			h256 word(bytesConstRef(_page.data() + offset, 0x20));
+			if (word != h256(0))
+				_out << "  " << std::uppercase << std::hex << std::setw(4) << (_index * Memory::c_pageSize + offset) << ": " << word.hex() << endl;
+		}
+	});
 	_out << "Storage dump:" << endl;
+	map<h256, h256> slots;
 	for (auto const& slot: storage)
 		if (slot.second != h256(0))
-			_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
+			slots.insert(slot);
+	for (auto const& slot: slots)
+		_out << "  " << slot.first.hex() << ": " << slot.second.hex() << endl;
 }
 
 void Interpreter::operator()(ExpressionStatement const& _expressionStatement)
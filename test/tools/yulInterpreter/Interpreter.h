@@ -28,7 +28,12 @@
 
 #include <libdevcore/Exceptions.h>
 
+#include <array>
+#include <functional>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 namespace yul
 {
@@ -60,14 +65,58 @@ enum class LoopState
 	Break,
 };
 
+/**
+ * Sparse byte-addressable memory covering the whole 256 bit address space (addresses
+ * wrap around). The memory is stored in pages that are allocated when they are first
+ * written to, unallocated pages read as zero. Pages with small indices are kept in a
+ * vector, the others in a map.
+ */
+class Memory
+{
+public:
+	static constexpr size_t c_pageSize = 0x1000;
+	using Page = std::array<uint8_t, c_pageSize>;
+
+	uint8_t get(dev::u256 const& _offset) const;
+	void set(dev::u256 const& _offset, uint8_t _value);
+	/// Reads @a _size bytes starting at @a _offset into @a _data.
+	void read(dev::u256 const& _offset, uint8_t* _data, size_t _size) const;
+	/// Writes @a _size bytes from @a _data starting at @a _offset.
+	/// Does not allocate pages for zero bytes.
+	void write(dev::u256 const& _offset, uint8_t const* _data, size_t _size);
+	/// Reads a big-endian word starting at @a _offset.
+	dev::u256 readWord(dev::u256 const& _offset) const;
+	/// Writes a big-endian word starting at @a _offset.
+	void writeWord(dev::u256 const& _offset, dev::u256 const& _value);
+
+	/// Calls @a _visitor with the index and contents of the allocated pages in the order of their addresses.
+	void forEachPage(std::function<void(dev::u256 const&, Page const&)> const& _visitor) const;
+
+private:
+	/// @returns the page with index @a _index or nullptr if it is not allocated.
+	Page const* page(dev::u256 const& _index) const;
+	Page& allocatePage(dev::u256 const& _index);
+
+	static constexpr size_t c_flatPages = 0x1000;
+	/// Pages with index below c_flatPages.
+	std::vector<std::unique_ptr<Page>> m_flatPages;
+	/// Pages with larger index.
+	std::map<dev::u256, std::unique_ptr<Page>> m_sparsePages;
+};
+
+struct StorageSlotHash
+{
+	size_t operator()(dev::h256 const& _slot) const;
+};
+
 struct InterpreterState
 {
 	dev::bytes calldata;
 	dev::bytes returndata;
-	std::map<dev::u256, uint8_t> memory;
+	Memory memory;
 	/// This is different than memory.size() because we ignore gas.
 	dev::u256 msize;
-	std::map<dev::h256, dev::h256> storage;
+	std::unordered_map<dev::h256, dev::h256, StorageSlotHash> storage;
 	dev::u160 address = 0x11111111;
 	dev::u256 balance = 0x22222222;
 	dev::u256 selfbalance = 0x22223333;